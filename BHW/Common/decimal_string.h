@@ -0,0 +1,188 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// Arithmetic on non-negative integers written as decimal digit strings without leading zeros ("0" for zero), as read
+// by the BHW tasks M, N and O. Each result is written right to left into a string allocated once at its final
+// length, plus at most one leading character that is dropped in place.
+//
+// Addition and subtraction take eight digits per step as one 64-bit word (SWAR), least significant digit in the
+// lowest byte. Digits are biased by 246 = 256 - 10 so that a byte sum of ten or more carries into the next byte
+// through the ordinary 64-bit addition; the bias is then taken back from the bytes that did not carry.
+
+inline constexpr uint64_t kDigitBlockLowBits = 0x0101010101010101;
+inline constexpr uint64_t kDigitBlockZeros = kDigitBlockLowBits * '0';
+inline constexpr uint64_t kDigitBlockBias = kDigitBlockLowBits * 246;
+
+// The eight digits at p as byte values, p[7] in the lowest byte. GCC does not fuse the portable byte loops into
+// one load or store with a byte swap, so little-endian GNU builds spell that out.
+inline uint64_t LoadDigitBlock(const char* p) {
+  uint64_t block = 0;
+#if defined(__GNUC__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+  std::memcpy(&block, p, 8);
+  block = __builtin_bswap64(block);
+#else
+  for (int i = 0; i < 8; ++i) {
+    block = block << 8 | static_cast<unsigned char>(p[i]);
+  }
+#endif
+  return block - kDigitBlockZeros;
+}
+
+inline void StoreDigitBlock(uint64_t digits, char* p) {
+  digits += kDigitBlockZeros;
+#if defined(__GNUC__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+  digits = __builtin_bswap64(digits);
+  std::memcpy(p, &digits, 8);
+#else
+  for (int i = 8; i-- > 0;) {
+    p[i] = static_cast<char>(digits);
+    digits >>= 8;
+  }
+#endif
+}
+
+// Digits of lhs + rhs + carry; carry becomes the carry out of the top digit.
+inline uint64_t AddDigitBlocks(uint64_t lhs, uint64_t rhs, unsigned& carry) {
+  const uint64_t biased = rhs + kDigitBlockBias;
+  uint64_t sum = lhs + biased;
+  unsigned overflow = sum < lhs;
+  sum += carry;
+  overflow |= sum < carry;
+  // Bit 8 k of sum ^ lhs ^ biased is the carry into byte k.
+  const uint64_t carry_out = ((sum ^ lhs ^ biased) >> 8 | uint64_t{overflow} << 56) & kDigitBlockLowBits;
+  carry = overflow;
+  return sum - (kDigitBlockLowBits & ~carry_out) * 246;
+}
+
+// Digits of lhs - rhs - borrow; borrow becomes the borrow out of the top digit.
+inline uint64_t SubtractDigitBlocks(uint64_t lhs, uint64_t rhs, unsigned& borrow) {
+  uint64_t difference = lhs - rhs;
+  unsigned underflow = lhs < rhs;
+  underflow |= difference < borrow;
+  difference -= borrow;
+  const uint64_t borrow_out = ((difference ^ lhs ^ rhs) >> 8 | uint64_t{underflow} << 56) & kDigitBlockLowBits;
+  borrow = underflow;
+  return difference - borrow_out * 246;
+}
+
+// Drops the leading zeros of digits, keeping one digit for zero, without reallocating.
+inline void TrimLeadingZeros(std::string& digits) {
+  size_t first = std::min(digits.find_first_not_of('0'), digits.size() - 1);
+  digits.erase(0, first);
+}
+
+inline std::string DecimalAdd(std::string_view lhs, std::string_view rhs) {
+  if (lhs.size() < rhs.size()) {
+    std::swap(lhs, rhs);
+  }
+  std::string result(lhs.size() + 1, '0');
+  const char* a = lhs.data() + lhs.size();
+  const char* b = rhs.data() + rhs.size();
+  char* out = result.data() + result.size();
+  unsigned carry = 0;
+  size_t i = 0;
+  for (; i + 8 <= rhs.size(); i += 8) {
+    a -= 8;
+    b -= 8;
+    out -= 8;
+    StoreDigitBlock(AddDigitBlocks(LoadDigitBlock(a), LoadDigitBlock(b), carry), out);
+  }
+  for (; i < rhs.size(); ++i) {
+    unsigned sum = (*--a - '0') + (*--b - '0') + carry;
+    carry = sum >= 10;
+    *--out = static_cast<char>('0' + sum - 10 * carry);
+  }
+  // The rest of lhs changes only along the run of nines the carry clears.
+  for (; i < lhs.size() && carry; ++i) {
+    char digit = *--a;
+    carry = digit == '9';
+    *--out = carry ? '0' : static_cast<char>(digit + 1);
+  }
+  std::copy(lhs.data(), a, out - (a - lhs.data()));
+  if (carry) {
+    result[0] = '1';
+  } else {
+    result.erase(0, 1);
+  }
+  return result;
+}
+
+// lhs - rhs for lhs >= rhs.
+inline std::string DecimalSubtract(std::string_view lhs, std::string_view rhs) {
+  std::string result(lhs.size(), '0');
+  const char* a = lhs.data() + lhs.size();
+  const char* b = rhs.data() + rhs.size();
+  char* out = result.data() + result.size();
+  unsigned borrow = 0;
+  size_t i = 0;
+  for (; i + 8 <= rhs.size(); i += 8) {
+    a -= 8;
+    b -= 8;
+    out -= 8;
+    StoreDigitBlock(SubtractDigitBlocks(LoadDigitBlock(a), LoadDigitBlock(b), borrow), out);
+  }
+  for (; i < rhs.size(); ++i) {
+    int difference = (*--a - '0') - (*--b - '0') - static_cast<int>(borrow);
+    borrow = difference < 0;
+    *--out = static_cast<char>('0' + difference + 10 * static_cast<int>(borrow));
+  }
+  for (; i < lhs.size() && borrow; ++i) {
+    char digit = *--a;
+    borrow = digit == '0';
+    *--out = borrow ? '9' : static_cast<char>(digit - 1);
+  }
+  std::copy(lhs.data(), a, out - (a - lhs.data()));
+  TrimLeadingZeros(result);
+  return result;
+}
+
+// Schoolbook product in base 10^9, nine digits per chunk, rather than digit by digit.
+inline std::string DecimalMultiply(std::string_view lhs, std::string_view rhs) {
+  const uint32_t kChunkBase = 1000000000;
+  const size_t kChunkDigits = 9;
+  if (lhs == "0" || rhs == "0") {
+    return "0";
+  }
+  auto to_chunks = [&](std::string_view digits) {
+    std::vector<uint32_t> chunks((digits.size() + kChunkDigits - 1) / kChunkDigits, 0);
+    size_t end = digits.size();
+    for (uint32_t& chunk : chunks) {
+      size_t begin = end >= kChunkDigits ? end - kChunkDigits : 0;
+      for (size_t i = begin; i < end; ++i) {
+        chunk = chunk * 10 + (digits[i] - '0');
+      }
+      end = begin;
+    }
+    return chunks;
+  };
+  const std::vector<uint32_t> a = to_chunks(lhs);
+  const std::vector<uint32_t> b = to_chunks(rhs);
+  std::vector<uint32_t> product(a.size() + b.size(), 0);
+  for (size_t i = 0; i < a.size(); ++i) {
+    uint64_t carry = 0;
+    for (size_t j = 0; j < b.size(); ++j) {
+      uint64_t current = product[i + j] + uint64_t{a[i]} * b[j] + carry;
+      product[i + j] = static_cast<uint32_t>(current % kChunkBase);
+      carry = current / kChunkBase;
+    }
+    product[i + b.size()] = static_cast<uint32_t>(carry);
+  }
+  std::string result(product.size() * kChunkDigits, '0');
+  char* out = result.data() + result.size();
+  for (uint32_t chunk : product) {
+    for (size_t i = 0; i < kChunkDigits; ++i) {
+      *--out = static_cast<char>('0' + chunk % 10);
+      chunk /= 10;
+    }
+  }
+  TrimLeadingZeros(result);
+  return result;
+}
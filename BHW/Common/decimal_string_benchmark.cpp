@@ -0,0 +1,129 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "decimal_string.h"
+
+// Build: g++ -std=c++17 -O2 decimal_string_benchmark.cpp -o decimal_string_benchmark
+
+static volatile size_t sink = 0;
+
+// The task M, N and O kernels before decimal_string.h, kept for comparison: digit by digit into a reversed string,
+// then reversed into a second one.
+std::string LegacyAdd(const std::string& a, const std::string& b) {
+  std::string reversed_result;
+  int carry = 0;
+  std::size_t n = std::max(a.size(), b.size());
+  for (std::size_t i = 0; i < n; ++i) {
+    int digit_a = (i < a.size()) ? a[a.size() - 1 - i] - '0' : 0;
+    int digit_b = (i < b.size()) ? b[b.size() - 1 - i] - '0' : 0;
+    int sum = digit_a + digit_b + carry;
+    reversed_result += static_cast<char>(sum % 10 + '0');
+    carry = sum / 10;
+  }
+  if (carry > 0) {
+    reversed_result += static_cast<char>(carry + '0');
+  }
+  std::string result;
+  result.reserve(reversed_result.size());
+  for (std::size_t i = reversed_result.size(); i-- > 0;) {
+    result += reversed_result[i];
+  }
+  return result;
+}
+
+std::string LegacySubtract(const std::string& a, const std::string& b) {
+  std::string reversed_result;
+  int carry = 0;
+  for (std::size_t i = 0; i < a.size(); ++i) {
+    int digit_a = a[a.size() - 1 - i] - '0';
+    int digit_b = (i < b.size()) ? b[b.size() - 1 - i] - '0' : 0;
+    int diff = digit_a - digit_b - carry;
+    carry = diff < 0;
+    reversed_result += static_cast<char>(diff + 10 * carry + '0');
+  }
+  while (reversed_result.size() > 1 && reversed_result.back() == '0') {
+    reversed_result.pop_back();
+  }
+  std::string result;
+  result.reserve(reversed_result.size());
+  for (std::size_t i = reversed_result.size(); i-- > 0;) {
+    result += reversed_result[i];
+  }
+  return result;
+}
+
+std::string LegacyMultiply(const std::string& a, const std::string& b) {
+  if (a == "0" || b == "0") {
+    return "0";
+  }
+  std::vector<int> result(a.size() + b.size(), 0);
+  for (std::size_t i = a.size(); i-- > 0;) {
+    for (std::size_t j = b.size(); j-- > 0;) {
+      int sum = (a[i] - '0') * (b[j] - '0') + result[i + j + 1];
+      result[i + j + 1] = sum % 10;
+      result[i + j] += sum / 10;
+    }
+  }
+  std::string product;
+  for (int digit : result) {
+    if (!product.empty() || digit != 0) {
+      product.push_back(static_cast<char>('0' + digit));
+    }
+  }
+  return product.empty() ? "0" : product;
+}
+
+std::string RandomDigits(size_t count, std::mt19937& rng) {
+  std::uniform_int_distribution<int> digit(0, 9);
+  std::string s(count, '0');
+  for (char& c : s) {
+    c = static_cast<char>('0' + digit(rng));
+  }
+  s[0] = '9';
+  return s;
+}
+
+// Stand-in for Google Benchmark, which the tree does not vendor: a case runs in batches of doubling size until one
+// takes at least 0.2 s and is reported in the same layout, with the throughput in operand digits.
+template <typename F>
+void RunBenchmark(const std::string& name, size_t digits, F f) {
+  for (size_t iterations = 1;; iterations *= 2) {
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < iterations; ++i) {
+      f();
+    }
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    if (elapsed.count() >= 2e8) {
+      double ns = elapsed.count() / static_cast<double>(iterations);
+      std::printf("%-28s %12.0f ns %12zu %12.1f digits/us\n", (name + "/" + std::to_string(digits)).c_str(), ns,
+                  iterations, static_cast<double>(digits) * 1e3 / ns);
+      return;
+    }
+  }
+}
+
+int main() {
+  std::mt19937 rng(42);
+  std::printf("%-28s %15s %12s %22s\n", "Benchmark", "Time", "Iterations", "Throughput");
+  for (size_t digits : {16, 1'000, 100'000}) {
+    const std::string a = RandomDigits(digits, rng);
+    const std::string b = RandomDigits(digits, rng);
+    RunBenchmark("BM_LegacyAdd", digits, [&] { sink = LegacyAdd(a, b).size(); });
+    RunBenchmark("BM_DecimalAdd", digits, [&] { sink = DecimalAdd(a, b).size(); });
+    const std::string& larger = std::max(a, b);
+    const std::string& smaller = std::min(a, b);
+    RunBenchmark("BM_LegacySubtract", digits, [&] { sink = LegacySubtract(larger, smaller).size(); });
+    RunBenchmark("BM_DecimalSubtract", digits, [&] { sink = DecimalSubtract(larger, smaller).size(); });
+  }
+  for (size_t digits : {16, 1'000, 10'000}) {
+    const std::string a = RandomDigits(digits, rng);
+    const std::string b = RandomDigits(digits, rng);
+    RunBenchmark("BM_LegacyMultiply", digits, [&] { sink = LegacyMultiply(a, b).size(); });
+    RunBenchmark("BM_DecimalMultiply", digits, [&] { sink = DecimalMultiply(a, b).size(); });
+  }
+  return 0;
+}
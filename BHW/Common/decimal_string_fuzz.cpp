@@ -0,0 +1,62 @@
+#include <cstdio>
+#include <cstdlib>
+#include <iterator>
+#include <limits>
+#include <random>
+#include <string>
+#include <utility>
+
+#include "../TaskL/big_integer.h"
+#include "decimal_string.h"
+
+// Differential fuzzer: checks DecimalAdd, DecimalSubtract and DecimalMultiply against BigInteger on random operands.
+// Build: g++ -std=c++17 -O2 -pthread ../TaskL/big_integer.cpp decimal_string_fuzz.cpp -o decimal_string_fuzz
+// Run:   ./decimal_string_fuzz [iterations] [seed]
+
+// Lengths cluster around the eight-digit blocks, and digits come in runs of nines and zeros half of the time, so
+// that carries and borrows ripple across blocks and through the tail of the longer operand.
+std::string RandomOperand(std::mt19937_64& rng) {
+  static const size_t kLengths[] = {1, 2, 7, 8, 9, 15, 16, 17, 24, 63, 64, 65};
+  size_t length = rng() % 2 ? kLengths[rng() % std::size(kLengths)] : 1 + rng() % 400;
+  const char* alphabet = rng() % 2 ? "0123456789" : "0999999999";
+  std::string digits(length, '0');
+  for (char& digit : digits) {
+    digit = alphabet[rng() % 10];
+  }
+  digits[0] = static_cast<char>('1' + rng() % 9);
+  if (rng() % 16 == 0) {
+    digits = "0";
+  }
+  return digits;
+}
+
+bool Check(const char* operation, const std::string& lhs, const std::string& rhs, const std::string& actual,
+           const BigInteger& expected) {
+  if (actual == expected.ToString()) {
+    return true;
+  }
+  std::printf("%s mismatch\nlhs: %s\nrhs: %s\ngot: %s\nexpected: %s\n", operation, lhs.c_str(), rhs.c_str(),
+              actual.c_str(), expected.ToString().c_str());
+  return false;
+}
+
+int main(int argc, char** argv) {
+  const size_t iterations = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 200000;
+  std::mt19937_64 rng(argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 1);
+  BigInteger::SetMaxDigits(std::numeric_limits<size_t>::max());
+  for (size_t i = 0; i < iterations; ++i) {
+    std::string lhs = RandomOperand(rng);
+    std::string rhs = RandomOperand(rng);
+    const BigInteger a(lhs);
+    const BigInteger b(rhs);
+    bool ok = Check("add", lhs, rhs, DecimalAdd(lhs, rhs), a + b) &&
+              Check("multiply", lhs, rhs, DecimalMultiply(lhs, rhs), a * b);
+    ok = ok && (a >= b ? Check("subtract", lhs, rhs, DecimalSubtract(lhs, rhs), a - b)
+                       : Check("subtract", rhs, lhs, DecimalSubtract(rhs, lhs), b - a));
+    if (!ok) {
+      return 1;
+    }
+  }
+  std::printf("%zu iterations passed\n", iterations);
+  return 0;
+}
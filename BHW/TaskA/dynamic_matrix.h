@@ -0,0 +1,271 @@
+#ifndef DYNAMIC_MATRIX_H_
+#define DYNAMIC_MATRIX_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <istream>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <stdexcept>
+#include <vector>
+
+#include "gemm.h"
+#include "matrix.h"
+
+class MatrixSizeMismatch : public std::invalid_argument {
+ public:
+  MatrixSizeMismatch() : std::invalid_argument("MatrixSizeMismatch") {
+  }
+};
+
+// The pool that large DynamicMatrix products are tiled over; null while they run on the calling thread.
+struct MatrixMultiplicationPoolSlot {
+  std::mutex mutex;
+  std::shared_ptr<WorkStealingPool> pool;
+};
+
+inline MatrixMultiplicationPoolSlot& GetMatrixMultiplicationPoolSlot() {
+  static MatrixMultiplicationPoolSlot slot;
+  return slot;
+}
+
+// Each product holds its own reference for as long as it runs. A pool replaced in the meantime keeps serving the
+// products already using it, and its workers are joined when the last of them returns.
+inline std::shared_ptr<WorkStealingPool> MatrixMultiplicationPool() {
+  auto& slot = GetMatrixMultiplicationPoolSlot();
+  std::lock_guard<std::mutex> lock(slot.mutex);
+  return slot.pool;
+}
+
+inline std::size_t GetMatrixMultiplicationThreads() {
+  auto pool = MatrixMultiplicationPool();
+  return pool ? pool->Size() : 1;
+}
+
+// Sets the number of threads, the calling one included, that later products are split across. 1 keeps them
+// serial. Safe to call while other threads multiply.
+inline void SetMatrixMultiplicationThreads(std::size_t threads) {
+  auto pool = threads > 1 ? std::make_shared<WorkStealingPool>(threads) : nullptr;
+  auto& slot = GetMatrixMultiplicationPoolSlot();
+  {
+    std::lock_guard<std::mutex> lock(slot.mutex);
+    slot.pool.swap(pool);
+  }
+  // Unless a product still holds it, the replaced pool is joined here, outside the lock.
+}
+
+// Products with fewer multiply-adds than this stay on the calling thread.
+inline constexpr std::size_t kParallelMatrixMinVolume = std::size_t{1} << 21;
+
+// Matrix whose size is chosen at run time, for sizes that would not fit Matrix on the stack. Elements are stored
+// row by row in one block aligned to a cache line, and products go through the blocked Gemm of gemm.h.
+template <typename T>
+class DynamicMatrix {
+ public:
+  DynamicMatrix() : rows_(0), cols_(0) {
+  }
+
+  DynamicMatrix(std::size_t rows, std::size_t cols, const T& value = T{})
+      : rows_(rows), cols_(cols), data_(rows * cols, value) {
+  }
+
+  template <std::size_t Rows, std::size_t Cols>
+  explicit DynamicMatrix(const Matrix<T, Rows, Cols>& matrix) : DynamicMatrix(Rows, Cols) {
+    for (std::size_t i = 0; i < Rows; ++i) {
+      for (std::size_t j = 0; j < Cols; ++j) {
+        (*this)(i, j) = matrix(i, j);
+      }
+    }
+  }
+
+  std::size_t RowsNumber() const noexcept {
+    return rows_;
+  }
+
+  std::size_t ColumnsNumber() const noexcept {
+    return cols_;
+  }
+
+  // Row-major elements; row i starts at Data() + i * ColumnsNumber().
+  T* Data() noexcept {
+    return data_.data();
+  }
+
+  const T* Data() const noexcept {
+    return data_.data();
+  }
+
+  T& operator()(std::size_t row, std::size_t col) {
+    return data_[row * cols_ + col];
+  }
+
+  const T& operator()(std::size_t row, std::size_t col) const {
+    return data_[row * cols_ + col];
+  }
+
+  T& At(std::size_t row, std::size_t col) {
+    if (row >= rows_ || col >= cols_) {
+      throw MatrixOutOfRange{};
+    }
+    return (*this)(row, col);
+  }
+
+  const T& At(std::size_t row, std::size_t col) const {
+    if (row >= rows_ || col >= cols_) {
+      throw MatrixOutOfRange{};
+    }
+    return (*this)(row, col);
+  }
+
+  DynamicMatrix& operator+=(const DynamicMatrix& other) {
+    CheckSameSize(other);
+    for (std::size_t i = 0; i < data_.size(); ++i) {
+      data_[i] += other.data_[i];
+    }
+    return *this;
+  }
+
+  DynamicMatrix& operator-=(const DynamicMatrix& other) {
+    CheckSameSize(other);
+    for (std::size_t i = 0; i < data_.size(); ++i) {
+      data_[i] -= other.data_[i];
+    }
+    return *this;
+  }
+
+  DynamicMatrix& operator*=(const DynamicMatrix& other) {
+    return *this = *this * other;
+  }
+
+  template <typename U>
+  DynamicMatrix& operator*=(const U& scalar) {
+    for (T& value : data_) {
+      value *= scalar;
+    }
+    return *this;
+  }
+
+  template <typename U>
+  DynamicMatrix& operator/=(const U& scalar) {
+    for (T& value : data_) {
+      value /= scalar;
+    }
+    return *this;
+  }
+
+  friend DynamicMatrix operator*(const DynamicMatrix& lhs, const DynamicMatrix& rhs) {
+    if (lhs.cols_ != rhs.rows_) {
+      throw MatrixSizeMismatch{};
+    }
+    const auto pool = MatrixMultiplicationPool();
+    if (pool == nullptr || lhs.rows_ * rhs.cols_ * lhs.cols_ < kParallelMatrixMinVolume) {
+      DynamicMatrix result(lhs.rows_, rhs.cols_);
+      Gemm(lhs.rows_, rhs.cols_, lhs.cols_, lhs.Data(), lhs.cols_, rhs.Data(), rhs.cols_, result.Data(), rhs.cols_);
+      return result;
+    }
+    // The tile that each thread will compute is zeroed, and so first touched, by that thread.
+    DynamicMatrix result(lhs.rows_, rhs.cols_, Uninitialized{});
+    ForEachGemmTile(*pool, lhs.rows_, rhs.cols_, [&](std::size_t row, std::size_t col, std::size_t rows,
+                                                     std::size_t cols) {
+      for (std::size_t i = row; i < row + rows; ++i) {
+        std::fill(&result(i, col), &result(i, col) + cols, T{});
+      }
+    });
+    ParallelGemm(lhs.rows_, rhs.cols_, lhs.cols_, lhs.Data(), lhs.cols_, rhs.Data(), rhs.cols_, result.Data(),
+                 rhs.cols_, *pool);
+    return result;
+  }
+
+  friend bool operator==(const DynamicMatrix& lhs, const DynamicMatrix& rhs) {
+    return lhs.rows_ == rhs.rows_ && lhs.cols_ == rhs.cols_ && lhs.data_ == rhs.data_;
+  }
+
+  friend bool operator!=(const DynamicMatrix& lhs, const DynamicMatrix& rhs) {
+    return !(lhs == rhs);
+  }
+
+ private:
+  struct Uninitialized {};
+
+  std::size_t rows_;
+  std::size_t cols_;
+  std::vector<T, AlignedAllocator<T>> data_;
+
+  DynamicMatrix(std::size_t rows, std::size_t cols, Uninitialized) : rows_(rows), cols_(cols), data_(rows * cols) {
+  }
+
+  void CheckSameSize(const DynamicMatrix& other) const {
+    if (rows_ != other.rows_ || cols_ != other.cols_) {
+      throw MatrixSizeMismatch{};
+    }
+  }
+};
+
+template <typename T>
+DynamicMatrix<T> GetTransposed(const DynamicMatrix<T>& matrix) {
+  DynamicMatrix<T> result(matrix.ColumnsNumber(), matrix.RowsNumber());
+  for (std::size_t i = 0; i < matrix.RowsNumber(); ++i) {
+    for (std::size_t j = 0; j < matrix.ColumnsNumber(); ++j) {
+      result(j, i) = matrix(i, j);
+    }
+  }
+  return result;
+}
+
+template <typename T>
+DynamicMatrix<T> operator+(DynamicMatrix<T> lhs, const DynamicMatrix<T>& rhs) {
+  lhs += rhs;
+  return lhs;
+}
+
+template <typename T>
+DynamicMatrix<T> operator-(DynamicMatrix<T> lhs, const DynamicMatrix<T>& rhs) {
+  lhs -= rhs;
+  return lhs;
+}
+
+template <typename T, typename U>
+DynamicMatrix<T> operator*(DynamicMatrix<T> matrix, const U& scalar) {
+  matrix *= scalar;
+  return matrix;
+}
+
+template <typename T, typename U>
+DynamicMatrix<T> operator*(const U& scalar, DynamicMatrix<T> matrix) {
+  matrix *= scalar;
+  return matrix;
+}
+
+template <typename T, typename U>
+DynamicMatrix<T> operator/(DynamicMatrix<T> matrix, const U& scalar) {
+  matrix /= scalar;
+  return matrix;
+}
+
+template <typename T>
+std::ostream& operator<<(std::ostream& os, const DynamicMatrix<T>& matrix) {
+  for (std::size_t i = 0; i < matrix.RowsNumber(); ++i) {
+    for (std::size_t j = 0; j < matrix.ColumnsNumber(); ++j) {
+      if (j > 0) {
+        os << ' ';
+      }
+      os << matrix(i, j);
+    }
+    os << '\n';
+  }
+  return os;
+}
+
+// Reads RowsNumber() x ColumnsNumber() values into a matrix of the wanted size.
+template <typename T>
+std::istream& operator>>(std::istream& is, DynamicMatrix<T>& matrix) {
+  for (std::size_t i = 0; i < matrix.RowsNumber(); ++i) {
+    for (std::size_t j = 0; j < matrix.ColumnsNumber(); ++j) {
+      is >> matrix(i, j);
+    }
+  }
+  return is;
+}
+
+#endif  // DYNAMIC_MATRIX_H_
@@ -0,0 +1,113 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "dynamic_matrix.h"
+
+// Build: g++ -std=c++17 -O2 -march=native -pthread dynamic_matrix_benchmark.cpp -o dynamic_matrix_benchmark
+
+template <class T>
+DynamicMatrix<T> RandomMatrix(std::size_t size, std::mt19937& rng) {
+  std::uniform_real_distribution<T> value(-1, 1);
+  DynamicMatrix<T> matrix(size, size);
+  for (std::size_t i = 0; i < size * size; ++i) {
+    matrix.Data()[i] = value(rng);
+  }
+  return matrix;
+}
+
+// The i-j-k loop of Matrix::operator*, which walks rhs down its columns, on DynamicMatrix storage: a Matrix of these
+// sizes does not fit on the stack.
+template <class T>
+DynamicMatrix<T> MatrixKernelProduct(const DynamicMatrix<T>& lhs, const DynamicMatrix<T>& rhs) {
+  const std::size_t n = lhs.RowsNumber();
+  DynamicMatrix<T> result(n, n);
+  for (std::size_t i = 0; i < n; ++i) {
+    for (std::size_t j = 0; j < n; ++j) {
+      for (std::size_t k = 0; k < n; ++k) {
+        result(i, j) += lhs(i, k) * rhs(k, j);
+      }
+    }
+  }
+  return result;
+}
+
+template <class F>
+double Seconds(F f) {
+  auto start = std::chrono::steady_clock::now();
+  f();
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  return elapsed.count();
+}
+
+// GFLOP/s of square products, 2 n^3 operations each. The old kernel is skipped past 1024, where it runs for minutes.
+template <class T>
+void SquareProducts(const char* type, std::mt19937& rng) {
+  for (std::size_t n : {256, 512, 1024, 2048, 4096}) {
+    const auto a = RandomMatrix<T>(n, rng);
+    const auto b = RandomMatrix<T>(n, rng);
+    const double flops = 2.0 * static_cast<double>(n) * static_cast<double>(n) * static_cast<double>(n);
+    DynamicMatrix<T> blocked;
+    const double blocked_gflops = flops / Seconds([&] { blocked = a * b; }) / 1e9;
+    if (n > 1024) {
+      std::printf("%-6s %6zu %14s %14.2f %9s\n", type, n, "-", blocked_gflops, "-");
+      continue;
+    }
+    DynamicMatrix<T> naive;
+    const double naive_gflops = flops / Seconds([&] { naive = MatrixKernelProduct(a, b); }) / 1e9;
+    T error = 0;
+    for (std::size_t i = 0; i < n * n; ++i) {
+      error = std::max<T>(error, std::abs(naive.Data()[i] - blocked.Data()[i]));
+    }
+    std::printf("%-6s %6zu %14.2f %14.2f %8.1fx  max |difference| %.1e\n", type, n, naive_gflops, blocked_gflops,
+                blocked_gflops / naive_gflops, static_cast<double>(error));
+  }
+}
+
+// GFLOP/s of square products on 1, 2, 4, ... threads up to hardware_concurrency, with the speedup over one thread
+// and the number of output tiles that were stolen from the thread they were first given to.
+template <class T>
+void ParallelScaling(const char* type, std::mt19937& rng) {
+  std::vector<std::size_t> thread_counts;
+  const std::size_t hardware = std::max(1u, std::thread::hardware_concurrency());
+  for (std::size_t threads = 1; threads < hardware; threads *= 2) {
+    thread_counts.push_back(threads);
+  }
+  thread_counts.push_back(hardware);
+  for (std::size_t n : {1024, 2048}) {
+    const auto a = RandomMatrix<T>(n, rng);
+    const auto b = RandomMatrix<T>(n, rng);
+    const double flops = 2.0 * static_cast<double>(n) * static_cast<double>(n) * static_cast<double>(n);
+    double single_gflops = 0;
+    for (std::size_t threads : thread_counts) {
+      SetMatrixMultiplicationThreads(threads);
+      const std::size_t steals = threads > 1 ? MatrixMultiplicationPool()->Steals() : 0;
+      DynamicMatrix<T> product;
+      const double gflops = flops / Seconds([&] { product = a * b; }) / 1e9;
+      single_gflops = threads == 1 ? gflops : single_gflops;
+      std::printf("%-6s %6zu %8zu %10.2f %8.2fx %8zu\n", type, n, threads, gflops, gflops / single_gflops,
+                  threads > 1 ? MatrixMultiplicationPool()->Steals() - steals : 0);
+    }
+  }
+  SetMatrixMultiplicationThreads(1);
+}
+
+int main() {
+  std::mt19937 rng(42);
+#ifdef GEMM_AVX2_FMA
+  std::printf("GFLOP/s of n x n products, AVX2/FMA microkernels\n");
+#else
+  std::printf("GFLOP/s of n x n products, portable microkernel\n");
+#endif
+  std::printf("%-6s %6s %14s %14s %9s\n", "type", "n", "Matrix loop", "blocked", "speedup");
+  SquareProducts<float>("float", rng);
+  SquareProducts<double>("double", rng);
+  std::printf("\nscaling on %u hardware threads\n%-6s %6s %8s %10s %9s %8s\n", std::thread::hardware_concurrency(),
+              "type", "n", "threads", "GFLOP/s", "speedup", "steals");
+  ParallelScaling<float>("float", rng);
+  ParallelScaling<double>("double", rng);
+  return 0;
+}
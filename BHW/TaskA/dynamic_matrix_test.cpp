@@ -0,0 +1,173 @@
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <sstream>
+#include <thread>
+#include <tuple>
+
+#include "dynamic_matrix.h"
+#include "dynamic_matrix.h"  // check include guards
+
+template <class T>
+DynamicMatrix<T> RandomMatrix(std::size_t rows, std::size_t cols, std::mt19937& rng) {
+  std::uniform_int_distribution<int> value(-9, 9);
+  DynamicMatrix<T> matrix(rows, cols);
+  for (std::size_t i = 0; i < rows; ++i) {
+    for (std::size_t j = 0; j < cols; ++j) {
+      matrix(i, j) = static_cast<T>(value(rng));
+    }
+  }
+  return matrix;
+}
+
+template <class T>
+DynamicMatrix<T> NaiveProduct(const DynamicMatrix<T>& lhs, const DynamicMatrix<T>& rhs) {
+  DynamicMatrix<T> result(lhs.RowsNumber(), rhs.ColumnsNumber());
+  for (std::size_t i = 0; i < lhs.RowsNumber(); ++i) {
+    for (std::size_t k = 0; k < lhs.ColumnsNumber(); ++k) {
+      for (std::size_t j = 0; j < rhs.ColumnsNumber(); ++j) {
+        result(i, j) += lhs(i, k) * rhs(k, j);
+      }
+    }
+  }
+  return result;
+}
+
+TEST_CASE("Construction", "[DynamicMatrix]") {
+  const DynamicMatrix<int> empty;
+  REQUIRE(empty.RowsNumber() == 0);
+  REQUIRE(empty.ColumnsNumber() == 0);
+
+  const DynamicMatrix<int> filled(2, 3, 7);
+  REQUIRE(filled.RowsNumber() == 2);
+  REQUIRE(filled.ColumnsNumber() == 3);
+  REQUIRE(filled(1, 2) == 7);
+  REQUIRE(reinterpret_cast<std::uintptr_t>(filled.Data()) % 64 == 0);
+
+  const Matrix<int, 2, 2> fixed{1, 2, -2, -1};
+  const DynamicMatrix<int> converted(fixed);
+  REQUIRE(converted(0, 1) == 2);
+  REQUIRE(converted(1, 0) == -2);
+}
+
+TEST_CASE("ElementAccess", "[DynamicMatrix]") {
+  DynamicMatrix<int> a(2, 3);
+  a(0, 2) = 7;
+  a.At(1, 1) = -1;
+  REQUIRE(a.Data()[2] == 7);
+  REQUIRE(a.Data()[4] == -1);
+  REQUIRE_THROWS_AS(a.At(2, 0), MatrixOutOfRange);  // NOLINT
+  REQUIRE_THROWS_AS(a.At(0, 3), MatrixOutOfRange);  // NOLINT
+}
+
+TEST_CASE("Arithmetic", "[DynamicMatrix]") {
+  std::mt19937 rng(1);
+  const auto a = RandomMatrix<int>(3, 4, rng);
+  const auto b = RandomMatrix<int>(3, 4, rng);
+  REQUIRE(a + b - b == a);
+  REQUIRE(a * 3 == a + a + a);
+  REQUIRE(3 * a / 3 == a);
+  REQUIRE(GetTransposed(GetTransposed(a)) == a);
+  REQUIRE(GetTransposed(a)(3, 2) == a(2, 3));
+  REQUIRE_THROWS_AS(a + GetTransposed(b), MatrixSizeMismatch);  // NOLINT
+  REQUIRE_THROWS_AS(a * b, MatrixSizeMismatch);                 // NOLINT
+
+  std::stringstream ss;
+  ss << a;
+  DynamicMatrix<int> read(3, 4);
+  ss >> read;
+  REQUIRE(read == a);
+}
+
+// Shapes around the tile sizes and the row, depth and column blocks of Gemm.
+TEST_CASE("Multiplication", "[DynamicMatrix]") {
+  std::mt19937 rng(2);
+  for (auto [m, k, n] : {std::tuple<std::size_t, std::size_t, std::size_t>{1, 1, 1}, {5, 7, 3}, {6, 16, 16},
+                         {13, 9, 17}, {97, 257, 31}, {192, 300, 48}, {7, 3, 2100}}) {
+    const auto ai = RandomMatrix<int64_t>(m, k, rng);
+    const auto bi = RandomMatrix<int64_t>(k, n, rng);
+    REQUIRE(ai * bi == NaiveProduct(ai, bi));
+
+    // Small integer entries keep every float and double product exact.
+    const auto ad = RandomMatrix<double>(m, k, rng);
+    const auto bd = RandomMatrix<double>(k, n, rng);
+    REQUIRE(ad * bd == NaiveProduct(ad, bd));
+    const auto af = RandomMatrix<float>(m, k, rng);
+    const auto bf = RandomMatrix<float>(k, n, rng);
+    REQUIRE(af * bf == NaiveProduct(af, bf));
+  }
+
+  DynamicMatrix<double> a(2, 2);
+  a(0, 0) = a(1, 1) = 1;
+  a(0, 1) = 2;
+  a *= a;
+  REQUIRE(a(0, 1) == 4);
+  REQUIRE(DynamicMatrix<double>(3, 0) * DynamicMatrix<double>(0, 2) == DynamicMatrix<double>(3, 2));
+}
+
+TEST_CASE("ParallelMultiplication", "[DynamicMatrix]") {
+  std::mt19937 rng(4);
+  const auto a = RandomMatrix<double>(301, 190, rng);
+  const auto b = RandomMatrix<double>(190, 530, rng);
+  const auto expected = a * b;
+  const auto ai = RandomMatrix<int64_t>(200, 150, rng);
+  const auto bi = RandomMatrix<int64_t>(150, 260, rng);
+  const auto expected_int = NaiveProduct(ai, bi);
+  // Several depth blocks, each cut by the edges of the row and column blocks.
+  const auto deep_a = RandomMatrix<float>(130, 600, rng);
+  const auto deep_b = RandomMatrix<float>(600, 270, rng);
+  const auto expected_deep = NaiveProduct(deep_a, deep_b);
+  for (std::size_t threads : {2, 3, 8}) {
+    SetMatrixMultiplicationThreads(threads);
+    REQUIRE(GetMatrixMultiplicationThreads() == threads);
+    REQUIRE(a * b == expected);
+    REQUIRE(ai * bi == expected_int);
+    REQUIRE(deep_a * deep_b == expected_deep);
+    REQUIRE(DynamicMatrix<double>(5, 5, 1) * DynamicMatrix<double>(5, 5, 1) == DynamicMatrix<double>(5, 5, 5));
+  }
+  SetMatrixMultiplicationThreads(1);
+  REQUIRE(GetMatrixMultiplicationThreads() == 1);
+}
+
+TEST_CASE("ThreadsChangedDuringMultiplication", "[DynamicMatrix]") {
+  std::mt19937 rng(5);
+  const auto a = RandomMatrix<int64_t>(200, 150, rng);
+  const auto b = RandomMatrix<int64_t>(150, 260, rng);
+  const auto expected = NaiveProduct(a, b);
+  SetMatrixMultiplicationThreads(2);
+  std::thread resizer([] {
+    for (std::size_t i = 0; i < 20; ++i) {
+      SetMatrixMultiplicationThreads(i % 3 + 1);
+    }
+  });
+  bool all_equal = true;
+  for (int i = 0; i < 10; ++i) {
+    all_equal = all_equal && a * b == expected;
+  }
+  resizer.join();
+  REQUIRE(all_equal);
+  SetMatrixMultiplicationThreads(1);
+}
+
+TEST_CASE("GemmStrides", "[DynamicMatrix]") {
+  // The top-left 10 x 10 corners of larger matrices, multiplied into the corner of a third that keeps its other
+  // values.
+  std::mt19937 rng(3);
+  const auto a = RandomMatrix<double>(20, 30, rng);
+  const auto b = RandomMatrix<double>(40, 50, rng);
+  auto c = RandomMatrix<double>(15, 25, rng);
+  const auto before = c;
+  Gemm<double>(10, 10, 10, a.Data(), 30, b.Data(), 50, c.Data(), 25);
+  for (std::size_t i = 0; i < 15; ++i) {
+    for (std::size_t j = 0; j < 25; ++j) {
+      double expected = before(i, j);
+      for (std::size_t k = 0; i < 10 && j < 10 && k < 10; ++k) {
+        expected += a(i, k) * b(k, j);
+      }
+      REQUIRE(c(i, j) == expected);
+    }
+  }
+}
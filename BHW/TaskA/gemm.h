@@ -0,0 +1,306 @@
+#ifndef GEMM_H_
+#define GEMM_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <new>
+#include <utility>
+#include <vector>
+
+#include "work_stealing_pool.h"
+
+#if defined(__GNUC__) && defined(__AVX2__) && defined(__FMA__)
+#include <immintrin.h>
+#define GEMM_AVX2_FMA
+#endif
+
+// Allocator handing out storage aligned to Alignment bytes, a cache line by default. Elements constructed without
+// arguments are default-initialized rather than value-initialized, so that vector(n) of a trivial type leaves its
+// memory untouched until the threads that will use it first write it.
+template <typename T, std::size_t Alignment = 64>
+struct AlignedAllocator {
+  using value_type = T;
+
+  template <typename U>
+  struct rebind {
+    using other = AlignedAllocator<U, Alignment>;
+  };
+
+  AlignedAllocator() = default;
+
+  template <typename U>
+  AlignedAllocator(const AlignedAllocator<U, Alignment>&) noexcept {  // NOLINT
+  }
+
+  T* allocate(std::size_t n) {
+    return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t{Alignment}));
+  }
+
+  void deallocate(T* p, std::size_t) noexcept {
+    ::operator delete(p, std::align_val_t{Alignment});
+  }
+
+  template <typename U>
+  void construct(U* p) {
+    ::new (static_cast<void*>(p)) U;
+  }
+
+  template <typename U, typename... Args>
+  void construct(U* p, Args&&... args) {
+    ::new (static_cast<void*>(p)) U(std::forward<Args>(args)...);
+  }
+
+  template <typename U>
+  bool operator==(const AlignedAllocator<U, Alignment>&) const noexcept {
+    return true;
+  }
+
+  template <typename U>
+  bool operator!=(const AlignedAllocator<U, Alignment>&) const noexcept {
+    return false;
+  }
+};
+
+// Rows and columns of C that one call of the microkernel computes, in registers. With AVX2 and FMA a float tile is
+// 6 x 16 and a double one 6 x 8, twelve ymm accumulators either way; other types and targets use a 4 x 8 tile of
+// plain loops that the compiler may vectorize.
+template <typename T>
+struct GemmTile {
+  static constexpr std::size_t kRows = 4;
+  static constexpr std::size_t kCols = 8;
+};
+
+#ifdef GEMM_AVX2_FMA
+template <>
+struct GemmTile<float> {
+  static constexpr std::size_t kRows = 6;
+  static constexpr std::size_t kCols = 16;
+};
+
+template <>
+struct GemmTile<double> {
+  static constexpr std::size_t kRows = 6;
+  static constexpr std::size_t kCols = 8;
+};
+#endif
+
+// Block sizes, in elements: a kGemmDepthBlock-deep panel of B tiles stays in L1 across a row of tiles, the
+// kGemmRowBlock x kGemmDepthBlock block of A in L2 and the kGemmDepthBlock x kGemmColumnBlock block of B in L3.
+// The row and column blocks are multiples of every tile size.
+inline constexpr std::size_t kGemmDepthBlock = 256;
+inline constexpr std::size_t kGemmRowBlock = 96;
+inline constexpr std::size_t kGemmColumnBlock = 2048;
+
+// c[kRows x kCols, row stride ldc] += a-panel * b-panel over depth steps; the a-panel holds kRows values per step and
+// the b-panel kCols values.
+template <typename T>
+void GemmMicroKernel(std::size_t depth, const T* a, const T* b, T* c, std::size_t ldc) {
+  constexpr std::size_t kRows = GemmTile<T>::kRows;
+  constexpr std::size_t kCols = GemmTile<T>::kCols;
+  T acc[kRows][kCols] = {};
+  for (std::size_t p = 0; p < depth; ++p, a += kRows, b += kCols) {
+    for (std::size_t i = 0; i < kRows; ++i) {
+      for (std::size_t j = 0; j < kCols; ++j) {
+        acc[i][j] += a[i] * b[j];
+      }
+    }
+  }
+  for (std::size_t i = 0; i < kRows; ++i) {
+    for (std::size_t j = 0; j < kCols; ++j) {
+      c[i * ldc + j] += acc[i][j];
+    }
+  }
+}
+
+#ifdef GEMM_AVX2_FMA
+// Each step broadcasts one value of A per row and multiplies it into the row's vectors of B.
+inline void GemmMicroKernel(std::size_t depth, const float* a, const float* b, float* c, std::size_t ldc) {
+  __m256 acc[6][2];
+#pragma GCC unroll 6
+  for (int i = 0; i < 6; ++i) {
+    acc[i][0] = _mm256_setzero_ps();
+    acc[i][1] = _mm256_setzero_ps();
+  }
+  for (std::size_t p = 0; p < depth; ++p, a += 6, b += 16) {
+    __m256 b0 = _mm256_load_ps(b);
+    __m256 b1 = _mm256_load_ps(b + 8);
+#pragma GCC unroll 6
+    for (int i = 0; i < 6; ++i) {
+      __m256 ai = _mm256_broadcast_ss(a + i);
+      acc[i][0] = _mm256_fmadd_ps(ai, b0, acc[i][0]);
+      acc[i][1] = _mm256_fmadd_ps(ai, b1, acc[i][1]);
+    }
+  }
+#pragma GCC unroll 6
+  for (int i = 0; i < 6; ++i) {
+    float* row = c + i * ldc;
+    _mm256_storeu_ps(row, _mm256_add_ps(_mm256_loadu_ps(row), acc[i][0]));
+    _mm256_storeu_ps(row + 8, _mm256_add_ps(_mm256_loadu_ps(row + 8), acc[i][1]));
+  }
+}
+
+inline void GemmMicroKernel(std::size_t depth, const double* a, const double* b, double* c, std::size_t ldc) {
+  __m256d acc[6][2];
+#pragma GCC unroll 6
+  for (int i = 0; i < 6; ++i) {
+    acc[i][0] = _mm256_setzero_pd();
+    acc[i][1] = _mm256_setzero_pd();
+  }
+  for (std::size_t p = 0; p < depth; ++p, a += 6, b += 8) {
+    __m256d b0 = _mm256_load_pd(b);
+    __m256d b1 = _mm256_load_pd(b + 4);
+#pragma GCC unroll 6
+    for (int i = 0; i < 6; ++i) {
+      __m256d ai = _mm256_broadcast_sd(a + i);
+      acc[i][0] = _mm256_fmadd_pd(ai, b0, acc[i][0]);
+      acc[i][1] = _mm256_fmadd_pd(ai, b1, acc[i][1]);
+    }
+  }
+#pragma GCC unroll 6
+  for (int i = 0; i < 6; ++i) {
+    double* row = c + i * ldc;
+    _mm256_storeu_pd(row, _mm256_add_pd(_mm256_loadu_pd(row), acc[i][0]));
+    _mm256_storeu_pd(row + 4, _mm256_add_pd(_mm256_loadu_pd(row + 4), acc[i][1]));
+  }
+}
+#endif
+
+// Copies rows x depth of A into panels of kRows rows, stored step by step, padding the last panel with zeros.
+template <typename T>
+void GemmPackA(std::size_t rows, std::size_t depth, const T* a, std::size_t lda, T* packed) {
+  constexpr std::size_t kRows = GemmTile<T>::kRows;
+  for (std::size_t i0 = 0; i0 < rows; i0 += kRows) {
+    for (std::size_t p = 0; p < depth; ++p) {
+      for (std::size_t i = i0; i < i0 + kRows; ++i) {
+        *packed++ = i < rows ? a[i * lda + p] : T{};
+      }
+    }
+  }
+}
+
+// Copies depth x cols of B into panels of kCols columns, stored step by step, padding the last panel with zeros.
+template <typename T>
+void GemmPackB(std::size_t depth, std::size_t cols, const T* b, std::size_t ldb, T* packed) {
+  constexpr std::size_t kCols = GemmTile<T>::kCols;
+  for (std::size_t j0 = 0; j0 < cols; j0 += kCols) {
+    std::size_t width = std::min(kCols, cols - j0);
+    for (std::size_t p = 0; p < depth; ++p) {
+      const T* row = b + p * ldb + j0;
+      std::copy(row, row + width, packed);
+      std::fill(packed + width, packed + kCols, T{});
+      packed += kCols;
+    }
+  }
+}
+
+// c (mc x nc, row stride ldc) += the packed mc x kc block of A * the packed kc x nc block of B, one microkernel call
+// per tile; tiles cut by the matrix edge are computed into a scratch tile first.
+template <typename T>
+void GemmMacroKernel(std::size_t mc, std::size_t nc, std::size_t kc, const T* packed_a, const T* packed_b, T* c,
+                     std::size_t ldc) {
+  constexpr std::size_t kRows = GemmTile<T>::kRows;
+  constexpr std::size_t kCols = GemmTile<T>::kCols;
+  for (std::size_t jr = 0; jr < nc; jr += kCols) {
+    for (std::size_t ir = 0; ir < mc; ir += kRows) {
+      const T* a_panel = packed_a + ir * kc;
+      const T* b_panel = packed_b + jr * kc;
+      T* c_tile = c + ir * ldc + jr;
+      if (ir + kRows <= mc && jr + kCols <= nc) {
+        GemmMicroKernel(kc, a_panel, b_panel, c_tile, ldc);
+        continue;
+      }
+      T scratch[kRows * kCols] = {};
+      GemmMicroKernel(kc, a_panel, b_panel, scratch, kCols);
+      for (std::size_t i = 0; i < std::min(kRows, mc - ir); ++i) {
+        for (std::size_t j = 0; j < std::min(kCols, nc - jr); ++j) {
+          c_tile[i * ldc + j] += scratch[i * kCols + j];
+        }
+      }
+    }
+  }
+}
+
+// Row-major c (m x n, row stride ldc) += a (m x k, row stride lda) * b (k x n, row stride ldb), T{} being zero.
+// Blocks of A and B are packed into the order the microkernel reads them, so that it streams through contiguous
+// memory whatever the strides.
+template <typename T>
+void Gemm(std::size_t m, std::size_t n, std::size_t k, const T* a, std::size_t lda, const T* b, std::size_t ldb, T* c,
+          std::size_t ldc) {
+  constexpr std::size_t kCols = GemmTile<T>::kCols;
+  const std::size_t padded_cols = (std::min(kGemmColumnBlock, n) + kCols - 1) / kCols * kCols;
+  std::vector<T, AlignedAllocator<T>> packed_a(kGemmRowBlock * kGemmDepthBlock);
+  std::vector<T, AlignedAllocator<T>> packed_b(std::min(kGemmDepthBlock, k) * padded_cols);
+  for (std::size_t jc = 0; jc < n; jc += kGemmColumnBlock) {
+    const std::size_t nc = std::min(kGemmColumnBlock, n - jc);
+    for (std::size_t pc = 0; pc < k; pc += kGemmDepthBlock) {
+      const std::size_t kc = std::min(kGemmDepthBlock, k - pc);
+      GemmPackB(kc, nc, b + pc * ldb + jc, ldb, packed_b.data());
+      for (std::size_t ic = 0; ic < m; ic += kGemmRowBlock) {
+        const std::size_t mc = std::min(kGemmRowBlock, m - ic);
+        GemmPackA(mc, kc, a + ic * lda + pc, lda, packed_a.data());
+        GemmMacroKernel(mc, nc, kc, packed_a.data(), packed_b.data(), c + ic * ldc + jc, ldc);
+      }
+    }
+  }
+}
+
+// Size of the output tiles ParallelGemm hands out, kGemmRowBlock rows by kGemmTileColumns columns. A multiple of
+// every tile size.
+inline constexpr std::size_t kGemmTileColumns = 256;
+
+// Calls tile(row, col, rows, cols) on pool for each tile of an m x n output, in the order ParallelGemm uses, so that
+// a pass over the output, such as its first-touch initialization, meets the same threads.
+template <class F>
+void ForEachGemmTile(WorkStealingPool& pool, std::size_t m, std::size_t n, F tile) {
+  const std::size_t tile_columns = (n + kGemmTileColumns - 1) / kGemmTileColumns;
+  const std::size_t tile_rows = (m + kGemmRowBlock - 1) / kGemmRowBlock;
+  pool.ForEach(tile_rows * tile_columns, [&](std::size_t index) {
+    const std::size_t row = index / tile_columns * kGemmRowBlock;
+    const std::size_t col = index % tile_columns * kGemmTileColumns;
+    tile(row, col, std::min(kGemmRowBlock, m - row), std::min(kGemmTileColumns, n - col));
+  });
+}
+
+// Gemm with the output cut into tiles that the threads of pool compute independently. All of A and B is packed once
+// up front, in kGemmRowBlock x kGemmDepthBlock and kGemmDepthBlock x kGemmTileColumns blocks shared by the tiles, so
+// that no block is packed twice; this takes a copy of both operands.
+template <typename T>
+void ParallelGemm(std::size_t m, std::size_t n, std::size_t k, const T* a, std::size_t lda, const T* b,
+                  std::size_t ldb, T* c, std::size_t ldc, WorkStealingPool& pool) {
+  constexpr std::size_t kBlockA = kGemmRowBlock * kGemmDepthBlock;
+  constexpr std::size_t kBlockB = kGemmDepthBlock * kGemmTileColumns;
+  const std::size_t row_blocks = (m + kGemmRowBlock - 1) / kGemmRowBlock;
+  const std::size_t depth_blocks = (k + kGemmDepthBlock - 1) / kGemmDepthBlock;
+  const std::size_t column_blocks = (n + kGemmTileColumns - 1) / kGemmTileColumns;
+  std::vector<T, AlignedAllocator<T>> packed_a(row_blocks * depth_blocks * kBlockA);
+  std::vector<T, AlignedAllocator<T>> packed_b(depth_blocks * column_blocks * kBlockB);
+  // Block (row, depth) of A is number row * depth_blocks + depth, block (depth, column) of B depth * column_blocks +
+  // column.
+  pool.ForEach((row_blocks + column_blocks) * depth_blocks, [&](std::size_t index) {
+    if (index < row_blocks * depth_blocks) {
+      const std::size_t row = index / depth_blocks * kGemmRowBlock;
+      const std::size_t depth = index % depth_blocks * kGemmDepthBlock;
+      GemmPackA(std::min(kGemmRowBlock, m - row), std::min(kGemmDepthBlock, k - depth), a + row * lda + depth, lda,
+                packed_a.data() + index * kBlockA);
+      return;
+    }
+    index -= row_blocks * depth_blocks;
+    const std::size_t depth = index / column_blocks * kGemmDepthBlock;
+    const std::size_t col = index % column_blocks * kGemmTileColumns;
+    GemmPackB(std::min(kGemmDepthBlock, k - depth), std::min(kGemmTileColumns, n - col), b + depth * ldb + col, ldb,
+              packed_b.data() + index * kBlockB);
+  });
+  ForEachGemmTile(pool, m, n, [&](std::size_t row, std::size_t col, std::size_t rows, std::size_t cols) {
+    const std::size_t row_block = row / kGemmRowBlock;
+    const std::size_t column_block = col / kGemmTileColumns;
+    for (std::size_t depth_block = 0; depth_block < depth_blocks; ++depth_block) {
+      const std::size_t depth = depth_block * kGemmDepthBlock;
+      GemmMacroKernel(rows, cols, std::min(kGemmDepthBlock, k - depth),
+                      packed_a.data() + (row_block * depth_blocks + depth_block) * kBlockA,
+                      packed_b.data() + (depth_block * column_blocks + column_block) * kBlockB,
+                      c + row * ldc + col, ldc);
+    }
+  });
+}
+
+#endif  // GEMM_H_
@@ -0,0 +1,176 @@
+#ifndef WORK_STEALING_POOL_H_
+#define WORK_STEALING_POOL_H_
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Runs batches of indexed tasks on a fixed set of threads, the thread calling ForEach being one of them. Every
+// thread gets its own queue, filled with a contiguous run of the indices, and takes tasks from its front; a thread
+// whose queue runs dry steals from the back of the others, so that uneven tasks still keep every thread busy.
+class WorkStealingPool {
+ public:
+  // threads >= 1 counts the caller, so threads - 1 workers are started.
+  explicit WorkStealingPool(std::size_t threads) {
+    for (std::size_t i = 0; i < std::max<std::size_t>(threads, 1); ++i) {
+      queues_.push_back(std::make_unique<Queue>());
+    }
+    for (std::size_t i = 1; i < queues_.size(); ++i) {
+      workers_.emplace_back([this, i] { Work(i); });
+    }
+  }
+
+  WorkStealingPool(const WorkStealingPool&) = delete;
+  WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+  ~WorkStealingPool() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stopping_ = true;
+    }
+    wake_.notify_all();
+    for (auto& worker : workers_) {
+      worker.join();
+    }
+  }
+
+  std::size_t Size() const {
+    return queues_.size();
+  }
+
+  // Calls task(i) for every i in [0, count) and returns once all calls have; the first exception a task throws is
+  // rethrown after that. A call from inside a task runs its tasks on the calling thread.
+  template <class F>
+  void ForEach(std::size_t count, F task) {
+    if (count == 0) {
+      return;
+    }
+    if (in_task_ || queues_.size() == 1) {
+      for (std::size_t i = 0; i < count; ++i) {
+        task(i);
+      }
+      return;
+    }
+    std::lock_guard<std::mutex> batch_lock(batch_mutex_);
+    // The runs are built aside, so that running out of memory leaves nothing published; swapping them in cannot throw.
+    std::vector<std::deque<std::size_t>> runs(queues_.size());
+    for (std::size_t q = 0; q < queues_.size(); ++q) {
+      for (std::size_t i = count * q / queues_.size(); i < count * (q + 1) / queues_.size(); ++i) {
+        runs[q].push_back(i);
+      }
+    }
+    task_ = std::ref(task);
+    error_ = nullptr;
+    remaining_.store(count);
+    for (std::size_t q = 0; q < queues_.size(); ++q) {
+      std::lock_guard<std::mutex> lock(queues_[q]->mutex);
+      queues_[q]->tasks.swap(runs[q]);
+    }
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      ++generation_;
+    }
+    wake_.notify_all();
+    Drain(0);
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_.wait(lock, [this] { return remaining_.load() == 0; });
+    task_ = nullptr;
+    if (error_) {
+      std::rethrow_exception(error_);
+    }
+  }
+
+  // Tasks run by some thread other than the one whose queue they were put in, since construction.
+  std::size_t Steals() const {
+    return steals_.load();
+  }
+
+ private:
+  struct Queue {
+    std::mutex mutex;
+    std::deque<std::size_t> tasks;
+  };
+
+  std::vector<std::unique_ptr<Queue>> queues_;
+  std::vector<std::thread> workers_;
+  std::mutex batch_mutex_;
+  std::mutex mutex_;
+  std::condition_variable wake_;
+  std::condition_variable done_;
+  std::function<void(std::size_t)> task_;
+  std::exception_ptr error_;
+  std::atomic<std::size_t> remaining_{0};
+  std::atomic<std::size_t> steals_{0};
+  std::size_t generation_ = 0;
+  bool stopping_ = false;
+
+  static inline thread_local bool in_task_ = false;
+
+  void Work(std::size_t index) {
+    std::size_t seen = 0;
+    while (true) {
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        wake_.wait(lock, [&] { return stopping_ || generation_ != seen; });
+        if (stopping_) {
+          return;
+        }
+        seen = generation_;
+      }
+      Drain(index);
+    }
+  }
+
+  // Runs tasks from queue index, then stolen ones, until every queue is empty.
+  void Drain(std::size_t index) {
+    std::size_t task;
+    while (Pop(index, task)) {
+      in_task_ = true;
+      try {
+        task_(task);
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!error_) {
+          error_ = std::current_exception();
+        }
+      }
+      in_task_ = false;
+      if (remaining_.fetch_sub(1) == 1) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        done_.notify_all();
+      }
+    }
+  }
+
+  bool Pop(std::size_t index, std::size_t& task) {
+    {
+      std::lock_guard<std::mutex> lock(queues_[index]->mutex);
+      if (!queues_[index]->tasks.empty()) {
+        task = queues_[index]->tasks.front();
+        queues_[index]->tasks.pop_front();
+        return true;
+      }
+    }
+    for (std::size_t i = 1; i < queues_.size(); ++i) {
+      Queue& victim = *queues_[(index + i) % queues_.size()];
+      std::lock_guard<std::mutex> lock(victim.mutex);
+      if (!victim.tasks.empty()) {
+        task = victim.tasks.back();
+        victim.tasks.pop_back();
+        steals_.fetch_add(1);
+        return true;
+      }
+    }
+    return false;
+  }
+};
+
+#endif  // WORK_STEALING_POOL_H_
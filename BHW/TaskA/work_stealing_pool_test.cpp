@@ -0,0 +1,63 @@
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "work_stealing_pool.h"
+#include "work_stealing_pool.h"  // check include guards
+
+TEST_CASE("EveryTaskRunsOnce", "[WorkStealingPool]") {
+  for (std::size_t threads : {1, 2, 3, 8}) {
+    WorkStealingPool pool(threads);
+    REQUIRE(pool.Size() == threads);
+    for (std::size_t count : {0, 1, 5, 1000}) {
+      std::vector<std::atomic<int>> runs(count);
+      pool.ForEach(count, [&](std::size_t i) { ++runs[i]; });
+      for (const auto& run : runs) {
+        REQUIRE(run.load() == 1);
+      }
+    }
+  }
+}
+
+TEST_CASE("UnevenTasksAreStolen", "[WorkStealingPool]") {
+  // The first thread's run of indices holds all the slow tasks, so the others finish theirs and take over.
+  WorkStealingPool pool(4);
+  std::atomic<int> done{0};
+  pool.ForEach(64, [&](std::size_t i) {
+    if (i < 16) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    ++done;
+  });
+  REQUIRE(done.load() == 64);
+  REQUIRE(pool.Steals() > 0);
+}
+
+TEST_CASE("ExceptionsReachTheCaller", "[WorkStealingPool]") {
+  WorkStealingPool pool(3);
+  std::atomic<int> done{0};
+  auto task = [&](std::size_t i) {
+    ++done;
+    if (i == 7) {
+      throw std::runtime_error("task 7");
+    }
+  };
+  REQUIRE_THROWS_AS(pool.ForEach(20, task), std::runtime_error);
+  REQUIRE(done.load() == 20);
+  pool.ForEach(10, [&](std::size_t) { ++done; });
+  REQUIRE(done.load() == 30);
+}
+
+TEST_CASE("NestedForEachRunsInline", "[WorkStealingPool]") {
+  WorkStealingPool pool(4);
+  std::vector<std::atomic<int>> runs(8 * 8);
+  pool.ForEach(8, [&](std::size_t i) { pool.ForEach(8, [&](std::size_t j) { ++runs[i * 8 + j]; }); });
+  for (const auto& run : runs) {
+    REQUIRE(run.load() == 1);
+  }
+}
@@ -0,0 +1,221 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+
+// Bump allocator over a list of heap chunks. Individual deallocations are no-ops; everything handed out is
+// returned to the heap at once by Release() or by the destructor.
+class MonotonicArena {
+ public:
+  static constexpr size_t kDefaultChunkSize = 4096;
+
+  explicit MonotonicArena(size_t initial_chunk_size = kDefaultChunkSize)
+      : head_(nullptr), current_(nullptr), end_(nullptr), next_chunk_size_(initial_chunk_size) {
+  }
+
+  MonotonicArena(const MonotonicArena&) = delete;
+  MonotonicArena& operator=(const MonotonicArena&) = delete;
+
+  ~MonotonicArena() {
+    Release();
+  }
+
+  void* Allocate(size_t bytes, size_t alignment) {
+    auto current = reinterpret_cast<uintptr_t>(current_);
+    auto aligned = (current + alignment - 1) & ~(alignment - 1);
+    if (current_ == nullptr || aligned + bytes > reinterpret_cast<uintptr_t>(end_)) {
+      AddChunk(bytes + alignment);
+      current = reinterpret_cast<uintptr_t>(current_);
+      aligned = (current + alignment - 1) & ~(alignment - 1);
+    }
+    current_ = reinterpret_cast<char*>(aligned + bytes);
+    ++allocations_;
+    return reinterpret_cast<void*>(aligned);
+  }
+
+  void Release() noexcept {
+    while (head_ != nullptr) {
+      Chunk* next = head_->next;
+      operator delete(head_);
+      head_ = next;
+    }
+    current_ = nullptr;
+    end_ = nullptr;
+  }
+
+  // Number of blocks handed out by Allocate().
+  size_t Allocations() const {
+    return allocations_;
+  }
+
+  // Number of chunks requested from the heap.
+  size_t Chunks() const {
+    return chunks_;
+  }
+
+ private:
+  struct alignas(std::max_align_t) Chunk {
+    Chunk* next;
+  };
+
+  Chunk* head_;
+  char* current_;
+  char* end_;
+  size_t next_chunk_size_;
+  size_t allocations_ = 0;
+  size_t chunks_ = 0;
+
+  void AddChunk(size_t min_bytes) {
+    size_t size = std::max(next_chunk_size_, min_bytes);
+    auto chunk = static_cast<Chunk*>(operator new(sizeof(Chunk) + size));
+    chunk->next = head_;
+    head_ = chunk;
+    current_ = reinterpret_cast<char*>(chunk + 1);
+    end_ = current_ + size;
+    next_chunk_size_ = size * 2;
+    ++chunks_;
+  }
+};
+
+template <typename T>
+class ArenaAllocator {
+ public:
+  using value_type = T;  // NOLINT
+  using propagate_on_container_copy_assignment = std::true_type;  // NOLINT
+  using propagate_on_container_move_assignment = std::true_type;  // NOLINT
+  using propagate_on_container_swap = std::true_type;  // NOLINT
+
+  explicit ArenaAllocator(MonotonicArena& arena) noexcept : arena_(&arena) {
+  }
+
+  template <typename U>
+  ArenaAllocator(const ArenaAllocator<U>& other) noexcept : arena_(other.Arena()) {  // NOLINT
+  }
+
+  T* allocate(size_t n) {  // NOLINT
+    return static_cast<T*>(arena_->Allocate(n * sizeof(T), alignof(T)));
+  }
+
+  void deallocate(T*, size_t) noexcept {  // NOLINT
+  }
+
+  MonotonicArena* Arena() const noexcept {
+    return arena_;
+  }
+
+  template <typename U>
+  friend bool operator==(const ArenaAllocator& lhs, const ArenaAllocator<U>& rhs) {
+    return lhs.arena_ == rhs.Arena();
+  }
+
+  template <typename U>
+  friend bool operator!=(const ArenaAllocator& lhs, const ArenaAllocator<U>& rhs) {
+    return !(lhs == rhs);
+  }
+
+ private:
+  MonotonicArena* arena_;
+};
+
+// Per-thread free lists of power-of-two blocks up to kMaxBlockSize bytes; larger requests go straight to the heap.
+// Freed blocks are cached by the thread that frees them and returned to the heap when that thread exits.
+class ThreadLocalPool {
+ public:
+  static constexpr size_t kMinBlockSize = 16;
+  static constexpr size_t kMaxBlockSize = 4096;
+
+  static void* Allocate(size_t bytes) {
+    if (bytes > kMaxBlockSize) {
+      return operator new(bytes);
+    }
+    FreeLists& lists = Local();
+    size_t index = ClassIndex(bytes);
+    if (Block* block = lists.heads[index]) {
+      lists.heads[index] = block->next;
+      return block;
+    }
+    return operator new(kMinBlockSize << index);
+  }
+
+  static void Deallocate(void* p, size_t bytes) noexcept {
+    if (bytes > kMaxBlockSize) {
+      operator delete(p);
+      return;
+    }
+    FreeLists& lists = Local();
+    size_t index = ClassIndex(bytes);
+    auto block = static_cast<Block*>(p);
+    block->next = lists.heads[index];
+    lists.heads[index] = block;
+  }
+
+ private:
+  struct Block {
+    Block* next;
+  };
+
+  static constexpr size_t kClassCount = 9;  // 16, 32, ..., 4096
+
+  struct FreeLists {
+    Block* heads[kClassCount] = {};
+
+    ~FreeLists() {
+      for (Block* head : heads) {
+        while (head != nullptr) {
+          Block* next = head->next;
+          operator delete(head);
+          head = next;
+        }
+      }
+    }
+  };
+
+  static FreeLists& Local() {
+    thread_local FreeLists lists;
+    return lists;
+  }
+
+  static size_t ClassIndex(size_t bytes) {
+    size_t index = 0;
+    while ((kMinBlockSize << index) < bytes) {
+      ++index;
+    }
+    return index;
+  }
+};
+
+template <typename T>
+class PoolAllocator {
+ public:
+  using value_type = T;  // NOLINT
+  using is_always_equal = std::true_type;  // NOLINT
+
+  static_assert(alignof(T) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__, "PoolAllocator does not support over-aligned types");
+
+  PoolAllocator() noexcept = default;
+
+  template <typename U>
+  PoolAllocator(const PoolAllocator<U>&) noexcept {  // NOLINT
+  }
+
+  T* allocate(size_t n) {  // NOLINT
+    return static_cast<T*>(ThreadLocalPool::Allocate(n * sizeof(T)));
+  }
+
+  void deallocate(T* p, size_t n) noexcept {  // NOLINT
+    ThreadLocalPool::Deallocate(p, n * sizeof(T));
+  }
+
+  template <typename U>
+  friend bool operator==(const PoolAllocator&, const PoolAllocator<U>&) {
+    return true;
+  }
+
+  template <typename U>
+  friend bool operator!=(const PoolAllocator&, const PoolAllocator<U>&) {
+    return false;
+  }
+};
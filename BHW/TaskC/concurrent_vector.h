@@ -0,0 +1,168 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "vector.h"
+
+// Append-only vector for many producer threads. Storage is a list of segments of doubling size that are never
+// moved, so PushBack/EmplaceBack are lock-free and the returned references stay valid until Freeze() or Clear().
+//
+// Other methods are not synchronized: an element pushed by another thread may be read only after synchronizing with
+// that thread, and Freeze(), Clear() and destruction require that no pushes are in flight.
+template <typename T>
+class ConcurrentVector {
+  static_assert(std::is_nothrow_move_constructible_v<T>,
+                "elements are built aside and moved into their slot, which must not fail after it is claimed");
+
+ public:
+  using ValueType = T;
+  using Reference = T&;
+  using ConstReference = const T&;
+  using SizeType = size_t;
+
+  ConcurrentVector() = default;
+
+  ConcurrentVector(const ConcurrentVector&) = delete;
+  ConcurrentVector& operator=(const ConcurrentVector&) = delete;
+
+  ~ConcurrentVector() {
+    Clear();
+    for (auto& segment : segments_) {
+      operator delete(segment.load(std::memory_order_relaxed));
+    }
+  }
+
+  Reference PushBack(const T& value) {
+    return EmplaceBack(value);
+  }
+
+  Reference PushBack(T&& value) {
+    return EmplaceBack(std::move(value));
+  }
+
+  template <typename... Args>
+  Reference EmplaceBack(Args&&... args) {
+    T value(std::forward<Args>(args)...);
+    SizeType index = size_.load(std::memory_order_relaxed);
+    T* slot = nullptr;
+    do {
+      slot = EnsureSegment(SegmentOf(index)) + OffsetOf(index);
+    } while (!size_.compare_exchange_weak(index, index + 1, std::memory_order_relaxed));
+    return *new (slot) T(std::move(value));
+  }
+
+  SizeType Size() const {
+    return size_.load(std::memory_order_acquire);
+  }
+
+  bool Empty() const {
+    return Size() == 0;
+  }
+
+  Reference operator[](SizeType index) {
+    return Segment(SegmentOf(index))[OffsetOf(index)];
+  }
+
+  ConstReference operator[](SizeType index) const {
+    return Segment(SegmentOf(index))[OffsetOf(index)];
+  }
+
+  Reference At(SizeType index) {
+    if (index >= Size()) {
+      throw ArrayOutOfRange();
+    }
+    return (*this)[index];
+  }
+
+  ConstReference At(SizeType index) const {
+    if (index >= Size()) {
+      throw ArrayOutOfRange();
+    }
+    return (*this)[index];
+  }
+
+  void Clear() noexcept {
+    ForEachSegment([](T* first, SizeType count) { std::destroy_n(first, count); });
+    size_.store(0, std::memory_order_relaxed);
+  }
+
+  // Moves all elements, in order, into one contiguous Vector with a single allocation and leaves *this empty.
+  // The segments are kept for reuse.
+  Vector<T> Freeze() {
+    Vector<T> result;
+    result.Reserve(Size());
+    ForEachSegment([&](T* first, SizeType count) {
+      result.Append(std::make_move_iterator(first), std::make_move_iterator(first + count));
+    });
+    Clear();
+    return result;
+  }
+
+ private:
+  static constexpr SizeType kFirstSegmentShift = 3;
+  static constexpr SizeType kFirstSegmentSize = SizeType{1} << kFirstSegmentShift;
+  static constexpr SizeType kSegmentCount = sizeof(SizeType) * 8 - kFirstSegmentShift;
+
+  // Segment k holds kFirstSegmentSize << k elements and starts at index kFirstSegmentSize * (2^k - 1).
+  static SizeType SegmentOf(SizeType index) {
+    SizeType x = index / kFirstSegmentSize + 1;
+#if defined(__GNUC__)
+    return sizeof(unsigned long long) * 8 - 1 - __builtin_clzll(x);  // NOLINT
+#else
+    SizeType k = 0;
+    while (x >>= 1) {
+      ++k;
+    }
+    return k;
+#endif
+  }
+
+  static SizeType SegmentBegin(SizeType segment) {
+    return kFirstSegmentSize * ((SizeType{1} << segment) - 1);
+  }
+
+  static SizeType SegmentSize(SizeType segment) {
+    return kFirstSegmentSize << segment;
+  }
+
+  static SizeType OffsetOf(SizeType index) {
+    return index - SegmentBegin(SegmentOf(index));
+  }
+
+  T* Segment(SizeType segment) const {
+    return segments_[segment].load(std::memory_order_acquire);
+  }
+
+  // Returns the segment, allocating it first if no thread has done so yet. Losing threads free their copy.
+  T* EnsureSegment(SizeType segment) {
+    T* existing = Segment(segment);
+    if (existing != nullptr) {
+      return existing;
+    }
+    auto fresh = static_cast<T*>(operator new(SegmentSize(segment) * sizeof(T)));
+    if (segments_[segment].compare_exchange_strong(existing, fresh, std::memory_order_acq_rel)) {
+      return fresh;
+    }
+    operator delete(fresh);
+    return existing;
+  }
+
+  template <typename F>
+  void ForEachSegment(F f) {
+    SizeType size = size_.load(std::memory_order_acquire);
+    for (SizeType segment = 0; SegmentBegin(segment) < size; ++segment) {
+      f(Segment(segment), std::min(SegmentSize(segment), size - SegmentBegin(segment)));
+    }
+  }
+
+  std::atomic<SizeType> size_{0};
+  std::atomic<T*> segments_[kSegmentCount] = {};
+};
@@ -0,0 +1,97 @@
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "concurrent_vector.h"
+#include "concurrent_vector.h"  // check include guards
+
+TEST_CASE("Sequential", "[ConcurrentVector]") {
+  ConcurrentVector<std::string> v;
+  REQUIRE(v.Empty());
+  const std::string* first = &v.PushBack("0");
+  for (int i = 1; i < 1000; ++i) {
+    v.EmplaceBack(std::to_string(i));
+  }
+  REQUIRE(first == &v[0]);
+  REQUIRE(v.Size() == 1000u);
+  for (int i = 0; i < 1000; ++i) {
+    REQUIRE(v.At(i) == std::to_string(i));
+  }
+  REQUIRE_THROWS_AS(v.At(1000), ArrayOutOfRange);
+
+  const Vector<std::string> frozen = v.Freeze();
+  REQUIRE(v.Empty());
+  REQUIRE(frozen.Size() == 1000u);
+  REQUIRE(frozen.Capacity() == 1000u);
+  for (int i = 0; i < 1000; ++i) {
+    REQUIRE(frozen[i] == std::to_string(i));
+  }
+
+  v.PushBack("again");
+  REQUIRE(v[0] == "again");
+}
+
+TEST_CASE("Concurrent Producers", "[ConcurrentVector]") {
+  const int threads = 4;
+  const int per_thread = 100000;
+  ConcurrentVector<std::unique_ptr<int>> v;
+  std::vector<std::vector<int*>> addresses(threads);
+
+  std::vector<std::thread> workers;
+  for (int t = 0; t < threads; ++t) {
+    workers.emplace_back([&, t] {
+      for (int i = 0; i < per_thread; ++i) {
+        addresses[t].push_back(v.EmplaceBack(std::make_unique<int>(t * per_thread + i)).get());
+      }
+    });
+  }
+  for (auto& worker : workers) {
+    worker.join();
+  }
+  REQUIRE(v.Size() == static_cast<size_t>(threads * per_thread));
+
+  std::vector<int*> seen;
+  for (size_t i = 0; i < v.Size(); ++i) {
+    seen.push_back(v[i].get());
+  }
+  std::sort(seen.begin(), seen.end());
+  for (const auto& list : addresses) {
+    for (int* p : list) {
+      REQUIRE(std::binary_search(seen.begin(), seen.end(), p));
+    }
+  }
+
+  const auto frozen = v.Freeze();
+  std::vector<int> values;
+  for (const auto& p : frozen) {
+    values.push_back(*p);
+  }
+  std::sort(values.begin(), values.end());
+  for (int i = 0; i < threads * per_thread; ++i) {
+    REQUIRE(values[i] == i);
+  }
+}
+
+struct ThrowOnNegative {
+  explicit ThrowOnNegative(int value) : value(value) {
+    if (value < 0) {
+      throw value;
+    }
+  }
+
+  int value;
+};
+
+TEST_CASE("Throwing Constructor", "[ConcurrentVector]") {
+  ConcurrentVector<ThrowOnNegative> v;
+  v.EmplaceBack(1);
+  REQUIRE_THROWS_AS(v.EmplaceBack(-1), int);
+  v.EmplaceBack(2);
+  REQUIRE(v.Size() == 2u);
+  REQUIRE(v[1].value == 2);
+}
@@ -0,0 +1,479 @@
+#pragma once
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include "vector.h"
+
+class MappedFileError : public std::runtime_error {
+ public:
+  explicit MappedFileError(const std::string& what) : std::runtime_error(what + ": " + std::strerror(errno)) {
+  }
+};
+
+// Vector of trivially copyable records living in a memory-mapped file. Opening an existing file maps it as is,
+// without reading or copying the elements; the file keeps a small header with the element count.
+// A moved-from MappedVector has no file: it reads as empty, Clear and PopBack do nothing, and anything that would
+// store elements throws std::logic_error until another vector is moved into it.
+template <typename T, typename GrowthPolicy = GrowthFactorTwo>
+class MappedVector {
+  static_assert(std::is_trivially_copyable_v<T>, "MappedVector stores raw bytes of its elements");
+
+ public:
+  using ValueType = T;
+  using Pointer = T*;
+  using ConstPointer = const T*;
+  using Reference = T&;
+  using ConstReference = const T&;
+  using SizeType = size_t;
+
+  using Iterator = T*;
+  using ConstIterator = const T*;
+  using ReverseIterator = std::reverse_iterator<Iterator>;
+  using ConstReverseIterator = std::reverse_iterator<ConstIterator>;
+
+  explicit MappedVector(const std::string& path) : fd_(open(path.c_str(), O_RDWR | O_CREAT, 0644)) {
+    if (fd_ < 0) {
+      throw MappedFileError("open " + path);
+    }
+    struct stat st {};
+    if (fstat(fd_, &st) != 0) {
+      close(fd_);
+      throw MappedFileError("fstat " + path);
+    }
+    auto file_size = static_cast<size_t>(st.st_size);
+    const bool created = file_size == 0;
+    if (created) {
+      file_size = kHeaderSize;
+      if (ftruncate(fd_, static_cast<off_t>(file_size)) != 0) {
+        close(fd_);
+        throw MappedFileError("ftruncate " + path);
+      }
+    } else if (file_size < kHeaderSize) {
+      close(fd_);
+      throw std::runtime_error("MappedVector: " + path + " is not a vector file");
+    }
+    Map(file_size);
+    // Only a file this constructor created, or one whose header is still all zeros, is taken over.
+    Header& header = GetHeader();
+    if (created || (header.magic == 0 && header.element_size == 0 && header.size == 0)) {
+      header.magic = kMagic;
+      header.element_size = sizeof(T);
+    } else if (header.magic != kMagic || header.element_size != sizeof(T)) {
+      Close();
+      throw std::runtime_error("MappedVector: " + path + " holds a different vector type");
+    }
+    if (header.size > capacity_) {
+      Close();
+      throw std::runtime_error("MappedVector: " + path + " is shorter than its header says");
+    }
+  }
+
+  MappedVector(const MappedVector&) = delete;
+  MappedVector& operator=(const MappedVector&) = delete;
+
+  MappedVector(MappedVector&& other) noexcept
+      : fd_(std::exchange(other.fd_, -1))
+      , mapping_(std::exchange(other.mapping_, nullptr))
+      , mapping_size_(std::exchange(other.mapping_size_, 0))
+      , capacity_(std::exchange(other.capacity_, 0)) {
+  }
+
+  MappedVector& operator=(MappedVector&& other) noexcept {
+    if (this != &other) {
+      Close();
+      fd_ = std::exchange(other.fd_, -1);
+      mapping_ = std::exchange(other.mapping_, nullptr);
+      mapping_size_ = std::exchange(other.mapping_size_, 0);
+      capacity_ = std::exchange(other.capacity_, 0);
+    }
+    return *this;
+  }
+
+  ~MappedVector() {
+    Close();
+  }
+
+  // Writes dirty pages back to the file and waits for the write to complete.
+  void Flush() {
+    if (mapping_ != nullptr && msync(mapping_, mapping_size_, MS_SYNC) != 0) {
+      throw MappedFileError("msync");
+    }
+  }
+
+  SizeType Size() const {
+    return mapping_ == nullptr ? 0 : GetHeader().size;
+  }
+
+  SizeType Capacity() const {
+    return capacity_;
+  }
+
+  bool Empty() const {
+    return Size() == 0;
+  }
+
+  Reference operator[](SizeType index) {
+    return Data()[index];
+  }
+
+  ConstReference operator[](SizeType index) const {
+    return Data()[index];
+  }
+
+  Reference At(SizeType index) {
+    if (index >= Size()) {
+      throw ArrayOutOfRange();
+    }
+    return Data()[index];
+  }
+
+  ConstReference At(SizeType index) const {
+    if (index >= Size()) {
+      throw ArrayOutOfRange();
+    }
+    return Data()[index];
+  }
+
+  Reference Front() {
+    return Data()[0];
+  }
+
+  ConstReference Front() const {
+    return Data()[0];
+  }
+
+  Reference Back() {
+    return Data()[Size() - 1];
+  }
+
+  ConstReference Back() const {
+    return Data()[Size() - 1];
+  }
+
+  Pointer Data() {
+    return mapping_ == nullptr ? nullptr : reinterpret_cast<Pointer>(static_cast<char*>(mapping_) + kHeaderSize);
+  }
+
+  ConstPointer Data() const {
+    return mapping_ == nullptr ? nullptr
+                               : reinterpret_cast<ConstPointer>(static_cast<const char*>(mapping_) + kHeaderSize);
+  }
+
+  void Swap(MappedVector& other) noexcept {
+    std::swap(fd_, other.fd_);
+    std::swap(mapping_, other.mapping_);
+    std::swap(mapping_size_, other.mapping_size_);
+    std::swap(capacity_, other.capacity_);
+  }
+
+  void Resize(SizeType new_size) {
+    Resize(new_size, T());
+  }
+
+  void Resize(SizeType new_size, const T& value) {
+    CheckMapped();
+    SizeType size = Size();
+    if (new_size > capacity_) {
+      Remap(new_size);
+    }
+    if (new_size > size) {
+      std::uninitialized_fill_n(Data() + size, new_size - size, value);
+    }
+    GetHeader().size = new_size;
+  }
+
+  // Like Resize, but new elements are default-initialized: the grown part of the file is not written before the
+  // caller fills it.
+  void ResizeDefaultInit(SizeType new_size) {
+    CheckMapped();
+    SizeType size = Size();
+    if (new_size > capacity_) {
+      Remap(new_size);
+    }
+    if (new_size > size) {
+      std::uninitialized_default_construct_n(Data() + size, new_size - size);
+    }
+    GetHeader().size = new_size;
+  }
+
+  void ResizeUninitialized(SizeType new_size) {
+    static_assert(std::is_trivially_default_constructible_v<T>,
+                  "ResizeUninitialized requires a trivial element type, use ResizeDefaultInit instead");
+    ResizeDefaultInit(new_size);
+  }
+
+  void Reserve(SizeType new_cap) {
+    if (new_cap > capacity_) {
+      Remap(new_cap);
+    }
+  }
+
+  void ShrinkToFit() {
+    if (capacity_ > Size()) {
+      Remap(Size());
+    }
+  }
+
+  void Clear() noexcept {
+    if (mapping_ != nullptr) {
+      GetHeader().size = 0;
+    }
+  }
+
+  void PushBack(const T& value) {
+    EmplaceBack(value);
+  }
+
+  void PushBack(T&& value) {
+    EmplaceBack(std::move(value));
+  }
+
+  template <typename... Args>
+  void EmplaceBack(Args&&... args) {
+    T value(std::forward<Args>(args)...);
+    SizeType size = Size();
+    if (size == capacity_) {
+      Remap(GrowthPolicy::NextCapacity(capacity_));
+    }
+    new (Data() + size) T(std::move(value));
+    GetHeader().size = size + 1;
+  }
+
+  // Like Vector::Insert, [first, last) must not point into this vector.
+  template <class InputIterator,
+            class = std::enable_if_t<std::is_base_of_v<
+                std::input_iterator_tag, typename std::iterator_traits<InputIterator>::iterator_category>>>
+  Iterator Insert(ConstIterator pos, InputIterator first, InputIterator last) {
+    SizeType position = pos - Data();
+    using Category = typename std::iterator_traits<InputIterator>::iterator_category;
+    if constexpr (std::is_base_of_v<std::forward_iterator_tag, Category>) {
+      SizeType count = std::distance(first, last);
+      std::uninitialized_copy(first, last, OpenGap(position, count));
+    } else {
+      SizeType old_size = Size();
+      for (; first != last; ++first) {
+        EmplaceBack(*first);
+      }
+      std::rotate(Data() + position, Data() + old_size, end());
+    }
+    return Data() + position;
+  }
+
+  Iterator Insert(ConstIterator pos, SizeType count, const T& value) {
+    SizeType position = pos - Data();
+    T copy(value);  // value may live in the part of the mapping that moves
+    std::uninitialized_fill_n(OpenGap(position, count), count, copy);
+    return Data() + position;
+  }
+
+  template <class InputIterator,
+            class = std::enable_if_t<std::is_base_of_v<
+                std::input_iterator_tag, typename std::iterator_traits<InputIterator>::iterator_category>>>
+  void Append(InputIterator first, InputIterator last) {
+    Insert(end(), first, last);
+  }
+
+  Iterator Erase(ConstIterator first, ConstIterator last) {
+    Pointer from = Data() + (first - Data());
+    Pointer to = Data() + (last - Data());
+    if (from != to) {
+      std::memmove(static_cast<void*>(from), static_cast<const void*>(to), (end() - to) * sizeof(T));
+      GetHeader().size -= to - from;
+    }
+    return from;
+  }
+
+  Iterator Erase(ConstIterator pos) {
+    return Erase(pos, pos + 1);
+  }
+
+  void PopBack() {
+    if (Size() > 0) {
+      --GetHeader().size;
+    }
+  }
+
+  friend bool operator==(const MappedVector& l_value, const MappedVector& r_value) {
+    return l_value.Size() == r_value.Size() && RangesEqual(l_value.Data(), r_value.Data(), l_value.Size());
+  }
+
+  friend bool operator!=(const MappedVector& l_value, const MappedVector& r_value) {
+    return !(l_value == r_value);
+  }
+
+  friend bool operator<(const MappedVector& l_value, const MappedVector& r_value) {
+    return RangesLess(l_value.Data(), l_value.Size(), r_value.Data(), r_value.Size());
+  }
+
+  friend bool operator>(const MappedVector& l_value, const MappedVector& r_value) {
+    return r_value < l_value;
+  }
+
+  friend bool operator<=(const MappedVector& l_value, const MappedVector& r_value) {
+    return !(r_value < l_value);
+  }
+
+  friend bool operator>=(const MappedVector& l_value, const MappedVector& r_value) {
+    return !(l_value < r_value);
+  }
+
+  Iterator begin() {  // NOLINT
+    return Data();
+  }
+
+  ConstIterator begin() const {  // NOLINT
+    return Data();
+  }
+
+  Iterator end() {  // NOLINT
+    return Data() + Size();
+  }
+
+  ConstIterator end() const {  // NOLINT
+    return Data() + Size();
+  }
+
+  ConstIterator cbegin() const {  // NOLINT
+    return begin();
+  }
+
+  ConstIterator cend() const {  // NOLINT
+    return end();
+  }
+
+  ReverseIterator rbegin() {  // NOLINT
+    return ReverseIterator(end());
+  }
+
+  ConstReverseIterator rbegin() const {  // NOLINT
+    return ConstReverseIterator(end());
+  }
+
+  ReverseIterator rend() {  // NOLINT
+    return ReverseIterator(begin());
+  }
+
+  ConstReverseIterator rend() const {  // NOLINT
+    return ConstReverseIterator(begin());
+  }
+
+  ConstReverseIterator crbegin() const {  // NOLINT
+    return ConstReverseIterator(cend());
+  }
+
+  ConstReverseIterator crend() const {  // NOLINT
+    return ConstReverseIterator(cbegin());
+  }
+
+ private:
+  struct Header {
+    uint64_t magic;
+    uint64_t element_size;
+    uint64_t size;
+  };
+
+  static constexpr uint64_t kMagic = 0x524f544345564d4dULL;  // "MMVECTOR"
+  static constexpr size_t kHeaderSize = std::max<size_t>(64, alignof(T));
+
+  int fd_;
+  void* mapping_ = nullptr;
+  size_t mapping_size_ = 0;
+  SizeType capacity_ = 0;
+
+  Header& GetHeader() {
+    return *static_cast<Header*>(mapping_);
+  }
+
+  const Header& GetHeader() const {
+    return *static_cast<const Header*>(mapping_);
+  }
+
+  void Map(size_t file_size) {
+    mapping_ = mmap(nullptr, file_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+    if (mapping_ == MAP_FAILED) {
+      mapping_ = nullptr;
+      close(fd_);
+      throw MappedFileError("mmap");
+    }
+    mapping_size_ = file_size;
+    capacity_ = (file_size - kHeaderSize) / sizeof(T);
+  }
+
+  void Unmap() noexcept {
+    if (mapping_ != nullptr) {
+      munmap(mapping_, mapping_size_);
+      mapping_ = nullptr;
+    }
+  }
+
+  void Close() noexcept {
+    Unmap();
+    if (fd_ >= 0) {
+      close(fd_);
+      fd_ = -1;
+    }
+  }
+
+  void CheckMapped() const {
+    if (mapping_ == nullptr) {
+      throw std::logic_error("MappedVector: the vector was moved from");
+    }
+  }
+
+  // Shifts the elements from position on by count, growing the file if needed, and returns the gap, whose elements
+  // count towards Size() but are not yet written.
+  Pointer OpenGap(SizeType position, SizeType count) {
+    SizeType size = Size();
+    if (count == 0) {
+      return Data() + position;
+    }
+    if (size + count > capacity_) {
+      Remap(std::max(GrowthPolicy::NextCapacity(capacity_), size + count));
+    }
+    Pointer gap = Data() + position;
+    std::memmove(static_cast<void*>(gap + count), static_cast<const void*>(gap), (size - position) * sizeof(T));
+    GetHeader().size = size + count;
+    return gap;
+  }
+
+  // Resizes the file to hold exactly new_capacity elements and moves the mapping along with it.
+  void Remap(SizeType new_capacity) {
+    CheckMapped();
+    size_t new_size = kHeaderSize + new_capacity * sizeof(T);
+    if (new_size > mapping_size_ && ftruncate(fd_, static_cast<off_t>(new_size)) != 0) {
+      throw MappedFileError("ftruncate");
+    }
+#ifdef MREMAP_MAYMOVE
+    void* mapping = mremap(mapping_, mapping_size_, new_size, MREMAP_MAYMOVE);
+    if (mapping == MAP_FAILED) {
+      throw MappedFileError("mremap");
+    }
+#else
+    void* mapping = mmap(nullptr, new_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+    if (mapping == MAP_FAILED) {
+      throw MappedFileError("mmap");
+    }
+    munmap(mapping_, mapping_size_);
+#endif
+    size_t old_size = std::exchange(mapping_size_, new_size);
+    mapping_ = mapping;
+    capacity_ = new_capacity;
+    if (new_size < old_size && ftruncate(fd_, static_cast<off_t>(new_size)) != 0) {
+      throw MappedFileError("ftruncate");
+    }
+  }
+};
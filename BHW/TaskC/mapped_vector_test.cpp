@@ -0,0 +1,187 @@
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#include <cstdio>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "mapped_vector.h"
+#include "mapped_vector.h"  // check include guards
+
+struct Record {
+  int64_t id;
+  double value;
+};
+
+class TempFile {
+ public:
+  TempFile() : path_("mapped_vector_test_" + std::to_string(getpid()) + ".bin") {
+    std::remove(path_.c_str());
+  }
+
+  ~TempFile() {
+    std::remove(path_.c_str());
+  }
+
+  const std::string& Path() const {
+    return path_;
+  }
+
+ private:
+  std::string path_;
+};
+
+TEST_CASE("Persistence", "[MappedVector]") {
+  TempFile file;
+  {
+    MappedVector<Record> v(file.Path());
+    REQUIRE(v.Empty());
+    for (int i = 0; i < 10000; ++i) {
+      v.PushBack({i, i * 0.5});
+    }
+    REQUIRE(v.Size() == 10000u);
+    REQUIRE(v.Capacity() >= 10000u);
+    v.Flush();
+  }
+  {
+    MappedVector<Record> v(file.Path());
+    REQUIRE(v.Size() == 10000u);
+    for (int i = 0; i < 10000; ++i) {
+      REQUIRE(v[i].id == i);
+      REQUIRE(v[i].value == i * 0.5);
+    }
+    v.Resize(10u);
+    v.ShrinkToFit();
+    REQUIRE(v.Capacity() == 10u);
+  }
+  {
+    MappedVector<Record> v(file.Path());
+    REQUIRE(v.Size() == 10u);
+    REQUIRE(v.Capacity() == 10u);
+    REQUIRE(v.Back().id == 9);
+    REQUIRE_THROWS_AS(v.At(10), ArrayOutOfRange);
+  }
+}
+
+TEST_CASE("Modifiers", "[MappedVector]") {
+  TempFile file;
+  MappedVector<int> v(file.Path());
+  v.Resize(5u, 7);
+  v.Reserve(100u);
+  REQUIRE(v.Capacity() == 100u);
+  v.EmplaceBack(8);
+  v.PushBack(v[0]);
+  REQUIRE(v.Size() == 7u);
+  REQUIRE(v[5] == 8);
+  REQUIRE(v[6] == 7);
+  v.PopBack();
+  v.Resize(2u);
+  v.Resize(4u);
+  REQUIRE(v[1] == 7);
+  REQUIRE(v[3] == 0);
+  v.Clear();
+  REQUIRE(v.Empty());
+
+  MappedVector<int> moved = std::move(v);
+  REQUIRE(moved.Capacity() == 100u);
+  REQUIRE(v.Data() == nullptr);
+  REQUIRE(v.Empty());
+  v.Clear();
+  v.PopBack();
+  REQUIRE_THROWS_AS(v.PushBack(1), std::logic_error);  // NOLINT
+  REQUIRE_THROWS_AS(v.Resize(0u), std::logic_error);   // NOLINT
+  v = std::move(moved);
+  v.PushBack(1);
+  REQUIRE(v.Size() == 1u);
+}
+
+TEST_CASE("Insert And Erase", "[MappedVector]") {
+  TempFile file;
+  MappedVector<int> v(file.Path());
+  const int values[] = {1, 2, 3, 4, 5};
+  v.Append(std::begin(values), std::end(values));
+  v.Insert(v.begin() + 1, 2u, v[4]);
+  REQUIRE(std::vector<int>(v.begin(), v.end()) == std::vector<int>{1, 5, 5, 2, 3, 4, 5});
+  std::istringstream input("8 9");
+  v.Insert(v.begin(), std::istream_iterator<int>(input), std::istream_iterator<int>());
+  REQUIRE(std::vector<int>(v.begin(), v.end()) == std::vector<int>{8, 9, 1, 5, 5, 2, 3, 4, 5});
+  REQUIRE(*v.Erase(v.begin() + 3, v.begin() + 5) == 2);
+  REQUIRE(*v.Erase(v.begin()) == 9);
+  REQUIRE(std::vector<int>(v.begin(), v.end()) == std::vector<int>{9, 1, 2, 3, 4, 5});
+
+  v.Insert(v.end(), 1000u, 6);
+  REQUIRE(v.Size() == 1006u);
+  REQUIRE(v.Back() == 6);
+  v.ResizeDefaultInit(2000u);
+  REQUIRE(v.Size() == 2000u);
+  REQUIRE(v[5] == 5);
+  v.ResizeUninitialized(3u);
+  REQUIRE(std::vector<int>(v.begin(), v.end()) == std::vector<int>{9, 1, 2});
+}
+
+// Trivially copyable, but only movable.
+struct MoveOnlyRecord {
+  explicit MoveOnlyRecord(int value) : value(value) {
+  }
+
+  MoveOnlyRecord(const MoveOnlyRecord&) = delete;
+  MoveOnlyRecord(MoveOnlyRecord&&) = default;
+
+  int value;
+};
+
+TEST_CASE("Move-Only Elements", "[MappedVector]") {
+  TempFile file;
+  MappedVector<MoveOnlyRecord> v(file.Path());
+  v.EmplaceBack(1);
+  v.PushBack(MoveOnlyRecord(2));
+  REQUIRE(v.Size() == 2u);
+  REQUIRE(v[1].value == 2);
+}
+
+TEST_CASE("Type Check", "[MappedVector]") {
+  TempFile file;
+  {
+    MappedVector<Record> v(file.Path());
+    v.PushBack({1, 1.0});
+  }
+  REQUIRE_THROWS_AS(MappedVector<int>(file.Path()), std::runtime_error);  // NOLINT
+}
+
+// Writes a 64-byte header of magic, element size and element count, with no elements after it.
+void WriteHeader(const std::string& path, uint64_t magic, uint64_t element_size, uint64_t size) {
+  const uint64_t header[8] = {magic, element_size, size};
+  std::FILE* file = std::fopen(path.c_str(), "wb");
+  REQUIRE(file != nullptr);
+  std::fwrite(header, sizeof(header), 1, file);
+  std::fclose(file);
+}
+
+TEST_CASE("Foreign Files", "[MappedVector]") {
+  TempFile file;
+  WriteHeader(file.Path(), 0, 0, 1000);
+  REQUIRE_THROWS_AS(MappedVector<int>(file.Path()), std::runtime_error);  // NOLINT
+  WriteHeader(file.Path(), 0, 4, 0);
+  REQUIRE_THROWS_AS(MappedVector<int>(file.Path()), std::runtime_error);  // NOLINT
+
+  // The right type, but claiming more elements than the file holds.
+  std::remove(file.Path().c_str());
+  {
+    MappedVector<int> v(file.Path());
+    v.PushBack(1);
+  }
+  std::FILE* source = std::fopen(file.Path().c_str(), "rb");
+  uint64_t header[8];
+  REQUIRE(std::fread(header, sizeof(header), 1, source) == 1u);
+  std::fclose(source);
+  WriteHeader(file.Path(), header[0], header[1], 1000);
+  REQUIRE_THROWS_AS(MappedVector<int>(file.Path()), std::runtime_error);  // NOLINT
+
+  WriteHeader(file.Path(), 0, 0, 0);
+  MappedVector<int> v(file.Path());
+  REQUIRE(v.Empty());
+  v.PushBack(7);
+  REQUIRE(v[0] == 7);
+}
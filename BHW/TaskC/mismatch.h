@@ -0,0 +1,153 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+#if defined(__GNUC__) && (defined(__AVX2__) || defined(__SSE2__))
+#include <immintrin.h>
+#endif
+
+#ifdef VECTOR_PARALLEL_COMPARISON
+#include <atomic>
+#include <thread>
+#include <vector>
+#endif
+
+// Element types for which "equal" means "same bytes", so ranges of them may be compared as raw memory: integers,
+// enums and pointers. Floating point types are excluded (NaN, -0.0), and so are class types, whose operator== and
+// operator< may look at only some of their bytes.
+template <typename T>
+inline constexpr bool kIsBitwiseComparable =
+    (std::is_integral_v<T> || std::is_enum_v<T> || std::is_pointer_v<T>) && std::has_unique_object_representations_v<T>;
+
+// Index of the first differing byte of two n-byte buffers, or n if they are equal.
+inline size_t BytewiseMismatch(const unsigned char* lhs, const unsigned char* rhs, size_t n) {
+  size_t i = 0;
+#if defined(__GNUC__) && defined(__AVX2__)
+  for (; i + 32 <= n; i += 32) {
+    __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(lhs + i));
+    __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rhs + i));
+    auto differ = ~static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(a, b)));
+    if (differ != 0) {
+      return i + __builtin_ctz(differ);
+    }
+  }
+#elif defined(__GNUC__) && defined(__SSE2__)
+  for (; i + 16 <= n; i += 16) {
+    __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(lhs + i));
+    __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rhs + i));
+    auto differ = ~static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(a, b))) & 0xFFFFu;
+    if (differ != 0) {
+      return i + __builtin_ctz(differ);
+    }
+  }
+#endif
+  for (; i < n; ++i) {
+    if (lhs[i] != rhs[i]) {
+      return i;
+    }
+  }
+  return n;
+}
+
+template <typename T>
+size_t SequentialMismatch(const T* lhs, const T* rhs, size_t n) {
+  if constexpr (kIsBitwiseComparable<T>) {
+    return BytewiseMismatch(reinterpret_cast<const unsigned char*>(lhs), reinterpret_cast<const unsigned char*>(rhs),
+                            n * sizeof(T)) /
+           sizeof(T);
+  } else {
+    return std::mismatch(lhs, lhs + n, rhs).first - lhs;
+  }
+}
+
+#ifdef VECTOR_PARALLEL_COMPARISON
+
+inline constexpr size_t kParallelComparisonMinBytes = size_t{1} << 24;
+
+// Splits the range between hardware threads. Each thread scans its part block by block and gives up as soon as
+// some thread has already found a mismatch earlier in the range.
+template <typename T>
+size_t ParallelMismatch(const T* lhs, const T* rhs, size_t n, size_t threads) {
+  const size_t block = std::max<size_t>(1, (size_t{1} << 16) / sizeof(T));
+  const size_t part = (n + threads - 1) / threads;
+  std::atomic<size_t> first(n);
+  auto scan = [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end && i < first.load(std::memory_order_relaxed); i += block) {
+      size_t len = std::min(block, end - i);
+      size_t found = i + SequentialMismatch(lhs + i, rhs + i, len);
+      if (found != i + len) {
+        size_t current = first.load(std::memory_order_relaxed);
+        while (found < current && !first.compare_exchange_weak(current, found, std::memory_order_relaxed)) {
+        }
+        return;
+      }
+    }
+  };
+  std::vector<std::thread> workers;
+  for (size_t t = 1; t < threads; ++t) {
+    workers.emplace_back(scan, std::min(n, t * part), std::min(n, (t + 1) * part));
+  }
+  scan(0, std::min(n, part));
+  for (auto& worker : workers) {
+    worker.join();
+  }
+  return first.load();
+}
+
+#endif  // VECTOR_PARALLEL_COMPARISON
+
+inline size_t ComparisonThreads([[maybe_unused]] size_t bytes) {
+#ifdef VECTOR_PARALLEL_COMPARISON
+  if (bytes >= kParallelComparisonMinBytes) {
+    return std::thread::hardware_concurrency();
+  }
+#endif
+  return 1;
+}
+
+// Index of the first position where lhs[i] != rhs[i], or n if the first n elements are equal.
+template <typename T>
+size_t MismatchIndex(const T* lhs, const T* rhs, size_t n) {
+#ifdef VECTOR_PARALLEL_COMPARISON
+  if (size_t threads = ComparisonThreads(n * sizeof(T)); threads > 1) {
+    return ParallelMismatch(lhs, rhs, n, threads);
+  }
+#endif
+  return SequentialMismatch(lhs, rhs, n);
+}
+
+template <typename T>
+bool RangesEqual(const T* lhs, const T* rhs, size_t n) {
+  if (n == 0) {
+    return true;
+  }
+  if constexpr (kIsBitwiseComparable<T>) {
+    if (ComparisonThreads(n * sizeof(T)) <= 1) {
+      return std::memcmp(lhs, rhs, n * sizeof(T)) == 0;
+    }
+  }
+  return MismatchIndex(lhs, rhs, n) == n;
+}
+
+template <typename T>
+bool RangesLess(const T* lhs, size_t lhs_size, const T* rhs, size_t rhs_size) {
+  if constexpr (!kIsBitwiseComparable<T>) {
+    return std::lexicographical_compare(lhs, lhs + lhs_size, rhs, rhs + rhs_size);
+  } else {
+    size_t common = std::min(lhs_size, rhs_size);
+    if constexpr (std::is_same_v<T, unsigned char> || std::is_same_v<T, std::byte>) {
+      if (ComparisonThreads(common) <= 1) {
+        int order = common == 0 ? 0 : std::memcmp(lhs, rhs, common);
+        return order != 0 ? order < 0 : lhs_size < rhs_size;
+      }
+    }
+    size_t i = common == 0 ? 0 : MismatchIndex(lhs, rhs, common);
+    if (i == common) {
+      return lhs_size < rhs_size;
+    }
+    return lhs[i] < rhs[i];
+  }
+}
@@ -0,0 +1,432 @@
+#pragma once
+
+#include <algorithm>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include "vector.h"
+
+// Vector with room for the first N elements inside the object itself; Allocator is asked for storage only past
+// that. As in Vector, the allocator is a private base and follows the propagate_on_container_* traits.
+template <typename T, size_t N, typename GrowthPolicy = GrowthFactorTwo, typename Allocator = std::allocator<T>>
+class SmallVector : private Allocator {
+  using AllocatorTraits = std::allocator_traits<Allocator>;
+
+  static constexpr bool kMoveAssignSteals = AllocatorTraits::propagate_on_container_move_assignment::value ||
+                                            AllocatorTraits::is_always_equal::value;
+
+ public:
+  using AllocatorType = Allocator;
+  using ValueType = T;
+  using Pointer = T*;
+  using ConstPointer = const T*;
+  using Reference = T&;
+  using ConstReference = const T&;
+  using SizeType = size_t;
+
+  using Iterator = T*;
+  using ConstIterator = const T*;
+  using ReverseIterator = std::reverse_iterator<Iterator>;
+  using ConstReverseIterator = std::reverse_iterator<ConstIterator>;
+
+  static constexpr SizeType kInlineCapacity = N;
+
+  SmallVector() : data_(InlineData()), size_(0), capacity_(N) {
+  }
+
+  explicit SmallVector(const Allocator& allocator)
+      : Allocator(allocator), data_(InlineData()), size_(0), capacity_(N) {
+  }
+
+  explicit SmallVector(SizeType size, const Allocator& allocator = Allocator()) : SmallVector(allocator) {
+    Reserve(size);
+    std::uninitialized_value_construct_n(data_, size);
+    size_ = size;
+  }
+
+  SmallVector(SizeType size, const T& value, const Allocator& allocator = Allocator()) : SmallVector(allocator) {
+    Reserve(size);
+    std::uninitialized_fill_n(data_, size, value);
+    size_ = size;
+  }
+
+  template <class InputIterator,
+            class = std::enable_if_t<std::is_base_of_v<
+                std::input_iterator_tag, typename std::iterator_traits<InputIterator>::iterator_category>>>
+  SmallVector(InputIterator first, InputIterator last, const Allocator& allocator = Allocator())
+      : SmallVector(allocator) {
+    const SizeType size = std::distance(first, last);
+    Reserve(size);
+    std::uninitialized_copy(first, last, data_);
+    size_ = size;
+  }
+
+  SmallVector(std::initializer_list<T> init, const Allocator& allocator = Allocator())
+      : SmallVector(init.begin(), init.end(), allocator) {
+  }
+
+  SmallVector(const SmallVector& other)
+      : SmallVector(other, AllocatorTraits::select_on_container_copy_construction(other.AllocatorRef())) {
+  }
+
+  SmallVector(const SmallVector& other, const Allocator& allocator)
+      : SmallVector(other.begin(), other.end(), allocator) {
+  }
+
+  SmallVector(SmallVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+      : SmallVector(std::move(other.AllocatorRef())) {
+    StealFrom(other);
+  }
+
+  SmallVector& operator=(const SmallVector& other) {
+    if (this != &other) {
+      constexpr bool kPropagate = AllocatorTraits::propagate_on_container_copy_assignment::value;
+      SmallVector tmp(other, kPropagate ? other.AllocatorRef() : AllocatorRef());
+      Release();
+      if constexpr (kPropagate) {
+        AllocatorRef() = other.AllocatorRef();
+      }
+      StealFrom(tmp);
+    }
+    return *this;
+  }
+
+  SmallVector& operator=(SmallVector&& other) noexcept(kMoveAssignSteals && std::is_nothrow_move_constructible_v<T>) {
+    if (this != &other) {
+      if (kMoveAssignSteals || AllocatorRef() == other.AllocatorRef()) {
+        Release();
+        if constexpr (AllocatorTraits::propagate_on_container_move_assignment::value) {
+          AllocatorRef() = std::move(other.AllocatorRef());
+        }
+        StealFrom(other);
+      } else {
+        SmallVector tmp(std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()), AllocatorRef());
+        Release();
+        StealFrom(tmp);
+      }
+    }
+    return *this;
+  }
+
+  ~SmallVector() {
+    Release();
+  }
+
+  Allocator GetAllocator() const {
+    return AllocatorRef();
+  }
+
+  SizeType Size() const {
+    return size_;
+  }
+
+  SizeType Capacity() const {
+    return capacity_;
+  }
+
+  bool Empty() const {
+    return size_ == 0;
+  }
+
+  bool IsInline() const {
+    return data_ == InlineData();
+  }
+
+  Reference operator[](SizeType index) {
+    return data_[index];
+  }
+
+  ConstReference operator[](SizeType index) const {
+    return data_[index];
+  }
+
+  Reference At(SizeType index) {
+    if (index >= size_) {
+      throw ArrayOutOfRange();
+    }
+    return data_[index];
+  }
+
+  ConstReference At(SizeType index) const {
+    if (index >= size_) {
+      throw ArrayOutOfRange();
+    }
+    return data_[index];
+  }
+
+  Reference Front() {
+    return data_[0];
+  }
+
+  ConstReference Front() const {
+    return data_[0];
+  }
+
+  Reference Back() {
+    return data_[size_ - 1];
+  }
+
+  ConstReference Back() const {
+    return data_[size_ - 1];
+  }
+
+  Pointer Data() {
+    return data_;
+  }
+
+  ConstPointer Data() const {
+    return data_;
+  }
+
+  // As with the standard containers, swapping heap buffers requires the allocators to be equal unless they propagate
+  // on swap.
+  void Swap(SmallVector& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+    if constexpr (AllocatorTraits::propagate_on_container_swap::value) {
+      std::swap(AllocatorRef(), other.AllocatorRef());
+    }
+    if (!IsInline() && !other.IsInline()) {
+      std::swap(data_, other.data_);
+      std::swap(size_, other.size_);
+      std::swap(capacity_, other.capacity_);
+      return;
+    }
+    SmallVector tmp(other.AllocatorRef());
+    tmp.StealFrom(other);
+    other.StealFrom(*this);
+    StealFrom(tmp);
+  }
+
+  void Resize(SizeType new_size) {
+    if (new_size > capacity_) {
+      ReallocateAndConstruct(new_size, new_size - size_,
+                             [&](Pointer p) { std::uninitialized_value_construct_n(p, new_size - size_); });
+      return;
+    }
+    if (new_size > size_) {
+      std::uninitialized_value_construct_n(data_ + size_, new_size - size_);
+    } else {
+      std::destroy(data_ + new_size, data_ + size_);
+    }
+    size_ = new_size;
+  }
+
+  void Resize(SizeType new_size, const T& value) {
+    if (new_size > capacity_) {
+      ReallocateAndConstruct(new_size, new_size - size_,
+                             [&](Pointer p) { std::uninitialized_fill_n(p, new_size - size_, value); });
+      return;
+    }
+    if (new_size > size_) {
+      std::uninitialized_fill_n(data_ + size_, new_size - size_, value);
+    } else {
+      std::destroy(data_ + new_size, data_ + size_);
+    }
+    size_ = new_size;
+  }
+
+  void Reserve(SizeType new_cap) {
+    if (new_cap > capacity_) {
+      ReallocateAndConstruct(new_cap, 0, [](Pointer) {});
+    }
+  }
+
+  void ShrinkToFit() {
+    if (IsInline() || capacity_ == size_) {
+      return;
+    }
+    if (size_ <= N) {
+      Pointer heap = data_;
+      UninitializedRelocate(heap, heap + size_, InlineData());
+      Dealloc(heap, capacity_);
+      data_ = InlineData();
+      capacity_ = N;
+    } else {
+      ReallocateAndConstruct(size_, 0, [](Pointer) {});
+    }
+  }
+
+  void Clear() noexcept {
+    std::destroy(data_, data_ + size_);
+    size_ = 0;
+  }
+
+  void PushBack(const T& value) {
+    EmplaceBack(value);
+  }
+
+  void PushBack(T&& value) {
+    EmplaceBack(std::move(value));
+  }
+
+  template <typename... Args>
+  void EmplaceBack(Args&&... args) {
+    if (size_ == capacity_) {
+      ReallocateAndConstruct(GrowthPolicy::NextCapacity(capacity_), 1,
+                             [&](Pointer p) { new (p) T(std::forward<Args>(args)...); });
+      return;
+    }
+    new (data_ + size_) T(std::forward<Args>(args)...);
+    ++size_;
+  }
+
+  void PopBack() {
+    if (size_ > 0) {
+      std::destroy_at(data_ + size_ - 1);
+      --size_;
+    }
+  }
+
+  friend bool operator==(const SmallVector& l_value, const SmallVector& r_value) {
+    return l_value.size_ == r_value.size_ && RangesEqual(l_value.data_, r_value.data_, l_value.size_);
+  }
+
+  friend bool operator!=(const SmallVector& l_value, const SmallVector& r_value) {
+    return !(l_value == r_value);
+  }
+
+  friend bool operator<(const SmallVector& l_value, const SmallVector& r_value) {
+    return RangesLess(l_value.data_, l_value.size_, r_value.data_, r_value.size_);
+  }
+
+  friend bool operator>(const SmallVector& l_value, const SmallVector& r_value) {
+    return r_value < l_value;
+  }
+
+  friend bool operator<=(const SmallVector& l_value, const SmallVector& r_value) {
+    return !(r_value < l_value);
+  }
+
+  friend bool operator>=(const SmallVector& l_value, const SmallVector& r_value) {
+    return !(l_value < r_value);
+  }
+
+  Iterator begin() {  // NOLINT
+    return data_;
+  }
+
+  ConstIterator begin() const {  // NOLINT
+    return data_;
+  }
+
+  Iterator end() {  // NOLINT
+    return data_ + size_;
+  }
+
+  ConstIterator end() const {  // NOLINT
+    return data_ + size_;
+  }
+
+  ConstIterator cbegin() const {  // NOLINT
+    return data_;
+  }
+
+  ConstIterator cend() const {  // NOLINT
+    return data_ + size_;
+  }
+
+  ReverseIterator rbegin() {  // NOLINT
+    return ReverseIterator(end());
+  }
+
+  ConstReverseIterator rbegin() const {  // NOLINT
+    return ConstReverseIterator(end());
+  }
+
+  ReverseIterator rend() {  // NOLINT
+    return ReverseIterator(begin());
+  }
+
+  ConstReverseIterator rend() const {  // NOLINT
+    return ConstReverseIterator(begin());
+  }
+
+  ConstReverseIterator crbegin() const {  // NOLINT
+    return ConstReverseIterator(cend());
+  }
+
+  ConstReverseIterator crend() const {  // NOLINT
+    return ConstReverseIterator(cbegin());
+  }
+
+ private:
+  Pointer data_;
+  SizeType size_;
+  SizeType capacity_;
+  alignas(T) unsigned char inline_[N == 0 ? 1 : N * sizeof(T)];
+
+  Pointer InlineData() {
+    return reinterpret_cast<Pointer>(inline_);
+  }
+
+  ConstPointer InlineData() const {
+    return reinterpret_cast<ConstPointer>(inline_);
+  }
+
+  Allocator& AllocatorRef() noexcept {
+    return *this;
+  }
+
+  const Allocator& AllocatorRef() const noexcept {
+    return *this;
+  }
+
+  Pointer Allocate(SizeType n) {
+    return AllocatorTraits::allocate(AllocatorRef(), n);
+  }
+
+  void Dealloc(Pointer p, SizeType n) {
+    AllocatorTraits::deallocate(AllocatorRef(), p, n);
+  }
+
+  void Release() noexcept {
+    Clear();
+    if (!IsInline()) {
+      Dealloc(data_, capacity_);
+    }
+    data_ = InlineData();
+    capacity_ = N;
+  }
+
+  // Expects *this to be empty and inline, and our allocator to be able to free other's heap buffer. That buffer is
+  // taken over as is; inline elements are relocated one by one, since they live inside other.
+  void StealFrom(SmallVector& other) {
+    if (other.IsInline()) {
+      UninitializedRelocate(other.data_, other.data_ + other.size_, data_);
+      size_ = other.size_;
+    } else {
+      data_ = other.data_;
+      size_ = other.size_;
+      capacity_ = other.capacity_;
+      other.data_ = other.InlineData();
+      other.capacity_ = N;
+    }
+    other.size_ = 0;
+  }
+
+  template <typename Construct>
+  void ReallocateAndConstruct(SizeType new_capacity, SizeType count, Construct construct) {
+    Pointer new_data = Allocate(new_capacity);
+    try {
+      construct(new_data + size_);
+    } catch (...) {
+      Dealloc(new_data, new_capacity);
+      throw;
+    }
+    try {
+      UninitializedRelocate(data_, data_ + size_, new_data);
+    } catch (...) {
+      std::destroy(new_data + size_, new_data + size_ + count);
+      Dealloc(new_data, new_capacity);
+      throw;
+    }
+    if (!IsInline()) {
+      Dealloc(data_, capacity_);
+    }
+    data_ = new_data;
+    size_ += count;
+    capacity_ = new_capacity;
+  }
+};
@@ -0,0 +1,171 @@
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "allocators.h"
+#include "small_vector.h"
+#include "small_vector.h"  // check include guards
+
+template <class T, size_t N>
+void Equal(const SmallVector<T, N>& real, const std::vector<T>& required) {
+  REQUIRE(real.Size() == required.size());
+  for (size_t i = 0u; i < real.Size(); ++i) {
+    REQUIRE(real[i] == required[i]);
+  }
+}
+
+TEST_CASE("Inline Storage", "[SmallVector]") {
+  SmallVector<int, 8> v;
+  REQUIRE(v.Empty());
+  REQUIRE(v.Capacity() == 8u);
+  REQUIRE(v.IsInline());
+
+  for (int i = 0; i < 8; ++i) {
+    v.PushBack(i);
+  }
+  REQUIRE(v.IsInline());
+  REQUIRE(v.Capacity() == 8u);
+
+  v.PushBack(8);
+  REQUIRE_FALSE(v.IsInline());
+  REQUIRE(v.Capacity() >= 9u);
+  Equal(v, {0, 1, 2, 3, 4, 5, 6, 7, 8});
+
+  v.Resize(3u);
+  v.ShrinkToFit();
+  REQUIRE(v.IsInline());
+  Equal(v, {0, 1, 2});
+}
+
+TEST_CASE("Constructors", "[SmallVector]") {
+  {
+    const SmallVector<std::string, 4> v(3u, "abc");
+    REQUIRE(v.IsInline());
+    Equal(v, std::vector<std::string>(3u, "abc"));
+  }
+
+  {
+    const SmallVector<std::string, 4> v(10u);
+    REQUIRE_FALSE(v.IsInline());
+    Equal(v, std::vector<std::string>(10u));
+  }
+
+  {
+    const SmallVector<int, 2> v{1, 2, 3};
+    const auto copy = v;
+    Equal(copy, {1, 2, 3});
+    REQUIRE(copy == v);
+  }
+}
+
+TEST_CASE("Move And Swap", "[SmallVector]") {
+  using Small = SmallVector<std::unique_ptr<int>, 4>;
+
+  SECTION("Inline move") {
+    Small a;
+    a.PushBack(std::make_unique<int>(1));
+    Small b = std::move(a);
+    REQUIRE(b.IsInline());
+    REQUIRE(*b[0] == 1);
+    REQUIRE(a.Empty());
+  }
+
+  SECTION("Heap move") {
+    Small a;
+    for (int i = 0; i < 10; ++i) {
+      a.PushBack(std::make_unique<int>(i));
+    }
+    const auto data = a.Data();
+    Small b;
+    b.PushBack(std::make_unique<int>(-1));
+    b = std::move(a);
+    REQUIRE(b.Data() == data);
+    REQUIRE(a.IsInline());
+    REQUIRE(a.Empty());
+    for (int i = 0; i < 10; ++i) {
+      REQUIRE(*b[i] == i);
+    }
+  }
+
+  SECTION("Swap inline and heap") {
+    Small a;
+    a.PushBack(std::make_unique<int>(-1));
+    Small b;
+    for (int i = 0; i < 10; ++i) {
+      b.PushBack(std::make_unique<int>(i));
+    }
+    a.Swap(b);
+    REQUIRE(b.IsInline());
+    REQUIRE(b.Size() == 1u);
+    REQUIRE(*b[0] == -1);
+    REQUIRE(a.Size() == 10u);
+    for (int i = 0; i < 10; ++i) {
+      REQUIRE(*a[i] == i);
+    }
+  }
+
+  SECTION("Swap inline and inline") {
+    SmallVector<std::string, 4> a{"a", "b"};
+    SmallVector<std::string, 4> b{"c"};
+    a.Swap(b);
+    Equal(a, {"c"});
+    Equal(b, {"a", "b"});
+    REQUIRE(a.IsInline());
+    REQUIRE(b.IsInline());
+  }
+}
+
+TEST_CASE("Aliasing PushBack", "[SmallVector]") {
+  SmallVector<std::string, 2> v{std::string(100u, 'a'), "b"};
+  v.PushBack(v[0]);
+  Equal(v, {std::string(100u, 'a'), "b", std::string(100u, 'a')});
+}
+
+TEST_CASE("Allocator", "[SmallVector]") {
+  using Arena = ArenaAllocator<int>;
+  using Small = SmallVector<int, 4, GrowthFactorTwo, Arena>;
+
+  MonotonicArena first_arena;
+  MonotonicArena second_arena;
+  Small a(Arena{first_arena});
+  for (int i = 0; i < 4; ++i) {
+    a.PushBack(i);
+  }
+  REQUIRE(a.IsInline());
+  REQUIRE(first_arena.Allocations() == 0u);
+
+  a.PushBack(4);
+  REQUIRE_FALSE(a.IsInline());
+  REQUIRE(first_arena.Allocations() == 1u);
+
+  Small b({10, 11, 12, 13, 14, 15}, Arena{second_arena});
+  REQUIRE(second_arena.Allocations() == 1u);
+
+  SECTION("Copy") {
+    const Small copy = a;
+    REQUIRE(copy.GetAllocator() == Arena{first_arena});
+    REQUIRE(first_arena.Allocations() == 2u);
+    REQUIRE(copy == a);
+  }
+
+  SECTION("Swap") {
+    const auto a_data = a.Data();
+    a.Swap(b);
+    REQUIRE(b.Data() == a_data);
+    REQUIRE(a.GetAllocator() == Arena{second_arena});
+    REQUIRE(b.GetAllocator() == Arena{first_arena});
+    REQUIRE(a.Size() == 6u);
+    REQUIRE(b.Size() == 5u);
+  }
+
+  SECTION("Move assignment") {
+    const auto b_data = b.Data();
+    a = std::move(b);
+    REQUIRE(a.Data() == b_data);
+    REQUIRE(a.GetAllocator() == Arena{second_arena});
+    REQUIRE(a.Front() == 10);
+  }
+}
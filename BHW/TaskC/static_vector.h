@@ -0,0 +1,459 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "vector.h"
+
+class StaticVectorOverflow : public std::length_error {
+ public:
+  StaticVectorOverflow() : std::length_error("StaticVector capacity exceeded") {
+  }
+};
+
+// What StaticVector does when an operation would need more than N elements.
+struct OverflowThrow {
+  static constexpr void Check(bool overflow) {
+    if (overflow) {
+      Fail();
+    }
+  }
+
+  [[noreturn]] static void Fail() {
+    throw StaticVectorOverflow();
+  }
+};
+
+struct OverflowAssert {
+  static constexpr void Check([[maybe_unused]] bool overflow) {
+    assert(!overflow);
+  }
+};
+
+struct OverflowUnchecked {
+  static constexpr void Check(bool) {
+  }
+};
+
+// Defined under C++20, where a constexpr constructor may leave an array uninitialized at run time and zero it only
+// during constant evaluation. C++17 has to zero it on every construction, copy and move.
+#if __cpp_constexpr >= 201907L && __cpp_lib_is_constant_evaluated >= 201811L
+#define STATIC_VECTOR_LAZY_ZEROING
+#endif
+
+// Largest element array, in bytes, that C++17 builds keep in constexpr storage; the zeroing then costs about as much
+// as touching the stack buffer, while larger buffers keep raw bytes and are not usable in constant expressions.
+inline constexpr size_t kStaticVectorConstexprBytes = 4096;
+
+// Whether StaticVector<T, N> can be used in constant expressions: for trivial T, always under C++20 and up to
+// kStaticVectorConstexprBytes under C++17.
+template <typename T, size_t N>
+#ifdef STATIC_VECTOR_LAZY_ZEROING
+inline constexpr bool kStaticVectorIsConstexpr = std::is_trivial_v<T>;
+#else
+inline constexpr bool kStaticVectorIsConstexpr = std::is_trivial_v<T> && N * sizeof(T) <= kStaticVectorConstexprBytes;
+#endif
+
+// Element storage of StaticVector. Objects are constructed in raw bytes and destroyed by hand.
+template <typename T, size_t N, bool = kStaticVectorIsConstexpr<T, N>>
+class StaticVectorStorage {
+ public:
+  StaticVectorStorage() {  // user-provided: bytes_ stay uninitialized even for const objects
+  }
+
+  StaticVectorStorage(const StaticVectorStorage&) = delete;
+  StaticVectorStorage& operator=(const StaticVectorStorage&) = delete;
+
+  ~StaticVectorStorage() {
+    std::destroy_n(Data(), size_);
+  }
+
+  T* Data() {
+    return reinterpret_cast<T*>(bytes_);
+  }
+
+  const T* Data() const {
+    return reinterpret_cast<const T*>(bytes_);
+  }
+
+  void AppendValues(size_t count) {
+    std::uninitialized_value_construct_n(Data() + size_, count);
+    size_ += count;
+  }
+
+  void AppendCopies(size_t count, const T& value) {
+    std::uninitialized_fill_n(Data() + size_, count, value);
+    size_ += count;
+  }
+
+  template <typename... Args>
+  T& Emplace(Args&&... args) {
+    T* p = new (Data() + size_) T(std::forward<Args>(args)...);
+    ++size_;
+    return *p;
+  }
+
+  void Truncate(size_t new_size) noexcept {
+    std::destroy(Data() + new_size, Data() + size_);
+    size_ = new_size;
+  }
+
+ protected:
+  size_t size_ = 0;
+
+ private:
+  alignas(T) unsigned char bytes_[N == 0 ? 1 : N * sizeof(T)];
+};
+
+// Trivial element types live in a plain array, so that StaticVector can be used in constant expressions, where every
+// element of a result must be initialized. With STATIC_VECTOR_LAZY_ZEROING the array is zeroed only there and left
+// as is at run time, like the raw bytes above.
+template <typename T, size_t N>
+class StaticVectorStorage<T, N, true> {
+ public:
+#ifdef STATIC_VECTOR_LAZY_ZEROING
+  constexpr StaticVectorStorage() {
+    if (std::is_constant_evaluated()) {
+      for (T& element : elements_) {
+        element = T();
+      }
+    }
+  }
+#else
+  constexpr StaticVectorStorage() = default;
+#endif
+
+  StaticVectorStorage(const StaticVectorStorage&) = delete;
+  StaticVectorStorage& operator=(const StaticVectorStorage&) = delete;
+
+  constexpr T* Data() {
+    return elements_;
+  }
+
+  constexpr const T* Data() const {
+    return elements_;
+  }
+
+  constexpr void AppendValues(size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+      elements_[size_++] = T();
+    }
+  }
+
+  constexpr void AppendCopies(size_t count, const T& value) {
+    for (size_t i = 0; i < count; ++i) {
+      elements_[size_++] = value;
+    }
+  }
+
+  template <typename... Args>
+  constexpr T& Emplace(Args&&... args) {
+    elements_[size_] = T(std::forward<Args>(args)...);
+    return elements_[size_++];
+  }
+
+  constexpr void Truncate(size_t new_size) noexcept {
+    size_ = new_size;
+  }
+
+ protected:
+  size_t size_ = 0;
+
+ private:
+#ifdef STATIC_VECTOR_LAZY_ZEROING
+  T elements_[N == 0 ? 1 : N];
+#else
+  T elements_[N == 0 ? 1 : N] = {};
+#endif
+};
+
+// Vector with a fixed capacity of N elements stored inside the object; it never touches the heap. Going past N is
+// handled by OverflowPolicy: OverflowThrow (the default), OverflowAssert or OverflowUnchecked.
+template <typename T, size_t N, typename OverflowPolicy = OverflowThrow>
+class StaticVector : private StaticVectorStorage<T, N> {
+  using Storage = StaticVectorStorage<T, N>;
+
+ public:
+  using ValueType = T;
+  using Pointer = T*;
+  using ConstPointer = const T*;
+  using Reference = T&;
+  using ConstReference = const T&;
+  using SizeType = size_t;
+
+  using Iterator = T*;
+  using ConstIterator = const T*;
+  using ReverseIterator = std::reverse_iterator<Iterator>;
+  using ConstReverseIterator = std::reverse_iterator<ConstIterator>;
+
+  constexpr StaticVector() = default;
+
+  constexpr explicit StaticVector(SizeType size) : Storage() {
+    OverflowPolicy::Check(size > N);
+    this->AppendValues(size);
+  }
+
+  constexpr StaticVector(SizeType size, const T& value) : Storage() {
+    OverflowPolicy::Check(size > N);
+    this->AppendCopies(size, value);
+  }
+
+  template <class InputIterator,
+            class = std::enable_if_t<std::is_base_of_v<
+                std::input_iterator_tag, typename std::iterator_traits<InputIterator>::iterator_category>>>
+  constexpr StaticVector(InputIterator first, InputIterator last) : Storage() {
+    for (; first != last; ++first) {
+      EmplaceBack(*first);
+    }
+  }
+
+  constexpr StaticVector(std::initializer_list<T> init) : StaticVector(init.begin(), init.end()) {
+  }
+
+  constexpr StaticVector(const StaticVector& other) : Storage() {
+    for (SizeType i = 0; i < other.size_; ++i) {
+      this->Emplace(other.Data()[i]);
+    }
+  }
+
+  // Moves the elements one by one and leaves other empty.
+  constexpr StaticVector(StaticVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>) : Storage() {
+    for (SizeType i = 0; i < other.size_; ++i) {
+      this->Emplace(std::move(other.Data()[i]));
+    }
+    other.Clear();
+  }
+
+  constexpr StaticVector& operator=(const StaticVector& other) {
+    if (this != &other) {
+      AssignFrom(other.Data(), other.size_);
+    }
+    return *this;
+  }
+
+  constexpr StaticVector& operator=(StaticVector&& other) noexcept(std::is_nothrow_move_assignable_v<T> &&
+                                                                   std::is_nothrow_move_constructible_v<T>) {
+    if (this != &other) {
+      AssignFrom(std::make_move_iterator(other.Data()), other.size_);
+      other.Clear();
+    }
+    return *this;
+  }
+
+  constexpr SizeType Size() const {
+    return this->size_;
+  }
+
+  constexpr SizeType Capacity() const {
+    return N;
+  }
+
+  constexpr bool Empty() const {
+    return this->size_ == 0;
+  }
+
+  constexpr Reference operator[](SizeType index) {
+    return Data()[index];
+  }
+
+  constexpr ConstReference operator[](SizeType index) const {
+    return Data()[index];
+  }
+
+  constexpr Reference At(SizeType index) {
+    if (index >= this->size_) {
+      throw ArrayOutOfRange();
+    }
+    return Data()[index];
+  }
+
+  constexpr ConstReference At(SizeType index) const {
+    if (index >= this->size_) {
+      throw ArrayOutOfRange();
+    }
+    return Data()[index];
+  }
+
+  constexpr Reference Front() {
+    return Data()[0];
+  }
+
+  constexpr ConstReference Front() const {
+    return Data()[0];
+  }
+
+  constexpr Reference Back() {
+    return Data()[this->size_ - 1];
+  }
+
+  constexpr ConstReference Back() const {
+    return Data()[this->size_ - 1];
+  }
+
+  constexpr Pointer Data() {
+    return Storage::Data();
+  }
+
+  constexpr ConstPointer Data() const {
+    return Storage::Data();
+  }
+
+  // Elements cannot change hands, so this swaps them pairwise and moves the tail of the longer vector over.
+  void Swap(StaticVector& other) noexcept(std::is_nothrow_move_constructible_v<T> && std::is_nothrow_swappable_v<T>) {
+    StaticVector& shorter = this->size_ <= other.size_ ? *this : other;
+    StaticVector& longer = this->size_ <= other.size_ ? other : *this;
+    SizeType common = shorter.size_;
+    std::swap_ranges(shorter.Data(), shorter.Data() + common, longer.Data());
+    for (SizeType i = common; i < longer.size_; ++i) {
+      shorter.Emplace(std::move(longer.Data()[i]));
+    }
+    longer.Truncate(common);
+  }
+
+  constexpr void Resize(SizeType new_size) {
+    OverflowPolicy::Check(new_size > N);
+    if (new_size > this->size_) {
+      this->AppendValues(new_size - this->size_);
+    } else {
+      this->Truncate(new_size);
+    }
+  }
+
+  constexpr void Resize(SizeType new_size, const T& value) {
+    OverflowPolicy::Check(new_size > N);
+    if (new_size > this->size_) {
+      this->AppendCopies(new_size - this->size_, value);
+    } else {
+      this->Truncate(new_size);
+    }
+  }
+
+  // The storage is already there: only checks that new_cap fits.
+  constexpr void Reserve(SizeType new_cap) {
+    OverflowPolicy::Check(new_cap > N);
+  }
+
+  constexpr void ShrinkToFit() {
+  }
+
+  constexpr void Clear() noexcept {
+    this->Truncate(0);
+  }
+
+  constexpr void PushBack(const T& value) {
+    EmplaceBack(value);
+  }
+
+  constexpr void PushBack(T&& value) {
+    EmplaceBack(std::move(value));
+  }
+
+  template <typename... Args>
+  constexpr void EmplaceBack(Args&&... args) {
+    OverflowPolicy::Check(this->size_ == N);
+    this->Emplace(std::forward<Args>(args)...);
+  }
+
+  constexpr void PopBack() {
+    if (this->size_ > 0) {
+      this->Truncate(this->size_ - 1);
+    }
+  }
+
+  friend bool operator==(const StaticVector& l_value, const StaticVector& r_value) {
+    return l_value.Size() == r_value.Size() && RangesEqual(l_value.Data(), r_value.Data(), l_value.Size());
+  }
+
+  friend bool operator!=(const StaticVector& l_value, const StaticVector& r_value) {
+    return !(l_value == r_value);
+  }
+
+  friend bool operator<(const StaticVector& l_value, const StaticVector& r_value) {
+    return RangesLess(l_value.Data(), l_value.Size(), r_value.Data(), r_value.Size());
+  }
+
+  friend bool operator>(const StaticVector& l_value, const StaticVector& r_value) {
+    return r_value < l_value;
+  }
+
+  friend bool operator<=(const StaticVector& l_value, const StaticVector& r_value) {
+    return !(r_value < l_value);
+  }
+
+  friend bool operator>=(const StaticVector& l_value, const StaticVector& r_value) {
+    return !(l_value < r_value);
+  }
+
+  constexpr Iterator begin() {  // NOLINT
+    return Data();
+  }
+
+  constexpr ConstIterator begin() const {  // NOLINT
+    return Data();
+  }
+
+  constexpr Iterator end() {  // NOLINT
+    return Data() + this->size_;
+  }
+
+  constexpr ConstIterator end() const {  // NOLINT
+    return Data() + this->size_;
+  }
+
+  constexpr ConstIterator cbegin() const {  // NOLINT
+    return begin();
+  }
+
+  constexpr ConstIterator cend() const {  // NOLINT
+    return end();
+  }
+
+  constexpr ReverseIterator rbegin() {  // NOLINT
+    return ReverseIterator(end());
+  }
+
+  constexpr ConstReverseIterator rbegin() const {  // NOLINT
+    return ConstReverseIterator(end());
+  }
+
+  constexpr ReverseIterator rend() {  // NOLINT
+    return ReverseIterator(begin());
+  }
+
+  constexpr ConstReverseIterator rend() const {  // NOLINT
+    return ConstReverseIterator(begin());
+  }
+
+  constexpr ConstReverseIterator crbegin() const {  // NOLINT
+    return ConstReverseIterator(cend());
+  }
+
+  constexpr ConstReverseIterator crend() const {  // NOLINT
+    return ConstReverseIterator(cbegin());
+  }
+
+ private:
+  // Assigns over the common prefix, then constructs or destroys the rest.
+  template <typename Iter>
+  constexpr void AssignFrom(Iter source, SizeType count) {
+    SizeType common = std::min(this->size_, count);
+    for (SizeType i = 0; i < common; ++i) {
+      Data()[i] = *source;
+      ++source;
+    }
+    if (count < this->size_) {
+      this->Truncate(count);
+    }
+    for (SizeType i = common; i < count; ++i) {
+      this->Emplace(*source);
+      ++source;
+    }
+  }
+};
@@ -0,0 +1,890 @@
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <type_traits>
+
+#include "static_vector.h"
+#include "static_vector.h"  // check include guards
+
+// Adapted from vector_public_test.cpp: capacity is fixed, nothing is ever reallocated, and growing past it throws.
+template <class T>
+using Static = StaticVector<T, 1024>;
+
+template <class T, size_t N, class Policy>
+void Equal(const StaticVector<T, N, Policy>& real, const std::vector<T>& required) {
+  REQUIRE(real.Size() == required.size());
+  for (size_t i = 0u; i < real.Size(); ++i) {
+    REQUIRE(real[i] == required[i]);
+  }
+}
+
+constexpr Static<int> MakeConstexpr() {
+  Static<int> v{1, 2, 3};
+  v.PushBack(4);
+  v.EmplaceBack(5);
+  v.Resize(7u, 6);
+  v.PopBack();
+  Static<int> copy;
+  copy = v;
+  return copy;
+}
+
+TEST_CASE("Member Types", "[StaticVector]") {
+  REQUIRE((std::is_same_v<Static<int>::ValueType, int>));
+  REQUIRE((std::is_same_v<Static<int>::Pointer, decltype(std::declval<Static<int>>().Data())>));
+  REQUIRE((std::is_same_v<Static<int>::ConstPointer, decltype(std::declval<const Static<int>>().Data())>));
+  REQUIRE((std::is_same_v<Static<int>::Reference, decltype(std::declval<Static<int>>()[0])>));
+  REQUIRE((std::is_same_v<Static<int>::Reference, decltype(std::declval<Static<int>>().At(0))>));
+  REQUIRE((std::is_same_v<Static<int>::Reference, decltype(std::declval<Static<int>>().Front())>));
+  REQUIRE((std::is_same_v<Static<int>::Reference, decltype(std::declval<Static<int>>().Back())>));
+  REQUIRE((std::is_same_v<Static<int>::ConstReference, decltype(std::declval<const Static<int>>()[0])>));
+  REQUIRE((std::is_same_v<Static<int>::ConstReference, decltype(std::declval<const Static<int>>().At(0))>));
+  REQUIRE((std::is_same_v<Static<int>::ConstReference, decltype(std::declval<const Static<int>>().Front())>));
+  REQUIRE((std::is_same_v<Static<int>::ConstReference, decltype(std::declval<const Static<int>>().Back())>));
+  REQUIRE((std::is_same_v<Static<int>::SizeType, decltype(std::declval<const Static<int>>().Size())>));
+  REQUIRE((std::is_same_v<Static<int>::SizeType, decltype(std::declval<const Static<int>>().Capacity())>));
+}
+
+TEST_CASE("Constexpr", "[StaticVector]") {
+  constexpr auto v = MakeConstexpr();
+  static_assert(v.Size() == 6u);
+  static_assert(v[0] == 1 && v[3] == 4 && v.Back() == 6);
+  static_assert(v.Capacity() == 1024u);
+  static_assert(kStaticVectorIsConstexpr<int, 1024>);
+  static_assert(!kStaticVectorIsConstexpr<std::string, 4>);
+  Equal(v, std::vector<int>{1, 2, 3, 4, 5, 6});
+}
+
+TEST_CASE("Default", "[Constructor]") {
+  const Static<int> v;
+  REQUIRE(v.Size() == 0u);
+  REQUIRE(v.Capacity() == 1024u);
+  REQUIRE(v.Data() != nullptr);
+  REQUIRE(v.Empty());
+}
+
+TEST_CASE("Single Parameter", "[Constructor]") {
+  {
+    const Static<std::string> v(5u);
+    Equal(v, std::vector<std::string>(5u));
+    REQUIRE(v.Capacity() == 1024u);
+    REQUIRE_FALSE(v.Empty());
+  }
+
+  {
+    const Static<std::unique_ptr<int>> v(200u);
+    Equal(v, std::vector<std::unique_ptr<int>>(200u));
+    REQUIRE_FALSE(v.Empty());
+  }
+
+  REQUIRE_FALSE((std::is_convertible_v<unsigned, Static<int>>));
+  REQUIRE_THROWS_AS(Static<int>(1025u), StaticVectorOverflow);  // NOLINT
+}
+
+TEST_CASE("FillInitialization", "[Constructor]") {
+  {
+    const Static<int> v(0, 5);
+    REQUIRE(v.Size() == 0u);
+  }
+
+  {
+    std::string_view filler = "abacababacacabacacbbcabcabracadabra";
+
+    const Static<std::string> v(5u, std::string(filler));
+    Equal(v, std::vector<std::string>(5u, std::string(filler)));
+  }
+
+  REQUIRE_THROWS_AS(Static<std::string>(2000u, "a"), StaticVectorOverflow);  // NOLINT
+}
+
+TEST_CASE("Iterators", "[Constructor]") {
+  const int arr[] = {1, 2, 3, 4};
+
+  {
+    const Static<int> v(arr, arr);
+    REQUIRE(v.Size() == 0u);
+  }
+
+  {
+    const Static<int> v(arr + 1, arr + 4);
+    Equal(v, std::vector<int>(arr + 1, arr + 4));
+  }
+
+  {
+    std::vector<std::unique_ptr<int>> p;
+    p.push_back(std::make_unique<int>(1));
+    p.push_back(std::make_unique<int>(2));
+
+    const Static<std::unique_ptr<int>> v(std::make_move_iterator(p.begin()), std::make_move_iterator(p.end()));
+    REQUIRE(*v[0] == 1);
+    REQUIRE(*v[1] == 2);
+    REQUIRE(p == std::vector<std::unique_ptr<int>>(2));
+  }
+
+  {
+    const std::vector<int> values(5u, 1);
+    REQUIRE_THROWS_AS((StaticVector<int, 4>(values.begin(), values.end())), StaticVectorOverflow);  // NOLINT
+  }
+}
+
+TEST_CASE("InitializerList", "[Constructor]") {
+  {
+    const Static<int> v{};
+    REQUIRE(v.Size() == 0u);
+  }
+
+  {
+    const Static<int> v{1, 2, 3, 4, 5};
+    Equal(v, std::vector<int>{1, 2, 3, 4, 5});
+  }
+}
+
+TEST_CASE("Copy Constructor", "[Constructor]") {
+  {
+    const Static<int> empty;
+    const auto v = empty;
+    REQUIRE(empty.Size() == 0u);
+    REQUIRE(v.Size() == 0u);
+  }
+
+  {
+    const Static<std::vector<int>> values{{1, 2}, {3, 4, 5}};
+    const auto v = values;
+    Equal(v, std::vector<std::vector<int>>{{1, 2}, {3, 4, 5}});
+    Equal(values, std::vector<std::vector<int>>{{1, 2}, {3, 4, 5}});
+  }
+}
+
+TEST_CASE("Move Constructor", "[Constructor]") {
+  {
+    Static<int> empty;
+    const auto v = std::move(empty);
+    REQUIRE(empty.Size() == 0u);
+    REQUIRE(v.Size() == 0u);
+  }
+
+  {
+    Static<std::vector<int>> values{{1, 2}, {3, 4, 5}};
+    const auto v = std::move(values);
+    Equal(v, std::vector<std::vector<int>>{{1, 2}, {3, 4, 5}});
+    REQUIRE(values.Size() == 0u);
+  }
+}
+
+TEST_CASE("Copy Assignment", "[Assignment]") {
+  SECTION("Empty to empty") {
+    const Static<int> empty;
+    Static<int> v;
+    v = empty;
+    REQUIRE(empty.Size() == 0u);
+    REQUIRE(v.Size() == 0u);
+
+    v = v;
+    REQUIRE(v.Size() == 0u);
+  }
+
+  SECTION("Empty to filled") {
+    const Static<int> empty;
+    Static<int> v{1, 2, 3};
+    v = empty;
+    REQUIRE(empty.Size() == 0u);
+    REQUIRE(v.Size() == 0u);
+  }
+
+  SECTION("Filled to empty") {
+    const Static<int> values{1, 2, 3};
+    Static<int> v;
+    v = values;
+    Equal(v, std::vector<int>{1, 2, 3});
+    Equal(values, std::vector<int>{1, 2, 3});
+
+    v = v;
+    Equal(v, std::vector<int>{1, 2, 3});
+    Equal(values, std::vector<int>{1, 2, 3});
+  }
+
+  SECTION("Small to large") {
+    Static<int> large(1000, 11);
+    const Static<int> small{1, 2, 3};
+    large = small;
+    Equal(large, std::vector<int>{1, 2, 3});
+    Equal(small, std::vector<int>{1, 2, 3});
+  }
+
+  SECTION("Large to small") {
+    const Static<int> large(1000, 11);
+    Static<int> small{1, 2, 3};
+    small = large;
+    Equal(large, std::vector<int>(1000, 11));
+    Equal(small, std::vector<int>(1000, 11));
+  }
+
+  SECTION("Deep copy") {
+    const Static<std::vector<int>> values{{1, 2}, {3, 4, 5}};
+    Static<std::vector<int>> v;
+    v = values;
+    Equal(v, std::vector<std::vector<int>>{{1, 2}, {3, 4, 5}});
+    Equal(values, std::vector<std::vector<int>>{{1, 2}, {3, 4, 5}});
+
+    v = v;
+    Equal(v, std::vector<std::vector<int>>{{1, 2}, {3, 4, 5}});
+    Equal(values, std::vector<std::vector<int>>{{1, 2}, {3, 4, 5}});
+  }
+}
+
+TEST_CASE("Move Assignment", "[Assignments]") {
+  SECTION("Empty to empty") {
+    Static<int> empty;
+    Static<int> v;
+
+    v = std::move(empty);
+    REQUIRE(empty.Size() == 0u);
+    REQUIRE(v.Size() == 0u);
+
+    v = Static<int>{};
+    REQUIRE(v.Size() == 0u);
+  }
+
+  SECTION("Empty to filled") {
+    Static<int> empty;
+    Static<int> v{1, 2, 3};
+    v = std::move(empty);
+    REQUIRE(empty.Size() == 0u);
+    REQUIRE(v.Size() == 0u);
+
+    v = Static<int>{1, 2, 3};
+    v = Static<int>{};
+    REQUIRE(v.Size() == 0u);
+  }
+
+  SECTION("Filled to empty") {
+    Static<std::string> values{"1", "2", "3"};
+    Static<std::string> v;
+    const auto pv = v.Data();
+    v = std::move(values);
+    Equal(v, std::vector<std::string>{"1", "2", "3"});
+    REQUIRE(pv == v.Data());
+    REQUIRE(values.Size() == 0u);
+
+    v = Static<std::string>{"4", "5", "6"};
+    Equal(v, std::vector<std::string>{"4", "5", "6"});
+  }
+
+  SECTION("Small to large") {
+    Static<int> large(1000, 11);
+    Static<int> small{1, 2, 3};
+    large = std::move(small);
+    Equal(large, std::vector<int>{1, 2, 3});
+    REQUIRE(small.Size() == 0u);
+  }
+
+  SECTION("Large to small") {
+    Static<int> large(1000, 11);
+    Static<int> small{1, 2, 3};
+    small = std::move(large);
+    Equal(small, std::vector<int>(1000, 11));
+    REQUIRE(large.Size() == 0u);
+  }
+}
+
+TEST_CASE("DataAccess", "[Methods]") {
+  Static<int> v{1, 2, 3, 4, 5};
+
+  {
+    REQUIRE(v.Front() == 1);
+    v.Front() = -1;
+    REQUIRE(std::as_const(v).Front() == -1);
+  }
+
+  {
+    REQUIRE(v.Back() == 5);
+    v.Back() = -5;
+    REQUIRE(std::as_const(v).Back() == -5);
+  }
+
+  {
+    REQUIRE(v[1] == 2);
+    v[1] = -2;
+    REQUIRE(std::as_const(v)[1] == -2);
+  }
+
+  {
+    REQUIRE(v.At(2) == 3);
+    v.At(2) = -3;
+    REQUIRE(std::as_const(v).At(2) == -3);
+    REQUIRE_THROWS_AS(v.At(5), std::out_of_range);                 // NOLINT
+    REQUIRE_THROWS_AS(std::as_const(v).At(5), std::out_of_range);  // NOLINT
+  }
+}
+
+TEST_CASE("Swap", "[DataManipulation]") {
+  SECTION("Empty to empty") {
+    Static<int> a;
+    Static<int> b;
+    a.Swap(b);
+    REQUIRE(a.Size() == 0u);
+    REQUIRE(b.Size() == 0u);
+  }
+
+  SECTION("Empty to filled") {
+    Static<std::string> a;
+    Static<std::string> b{"1", "2", "3"};
+    const auto pa = a.Data();
+    a.Swap(b);
+    Equal(a, std::vector<std::string>{"1", "2", "3"});
+    REQUIRE(a.Data() == pa);
+    REQUIRE(b.Size() == 0u);
+  }
+
+  SECTION("Small to large") {
+    Static<int> large(1000, 11);
+    Static<int> small{1, 2, 3};
+    small.Swap(large);
+    Equal(small, std::vector<int>(1000, 11));
+    Equal(large, std::vector<int>{1, 2, 3});
+  }
+}
+
+TEST_CASE("Clear", "[DataManipulation]") {
+  {
+    Static<std::unique_ptr<int>> empty;
+    empty.Clear();
+    REQUIRE(empty.Size() == 0u);
+  }
+
+  {
+    Static<int> v(1000, 11);
+    v.Clear();
+    REQUIRE(v.Size() == 0u);
+    REQUIRE(v.Empty());
+  }
+
+  {
+    Static<std::unique_ptr<int>> v(2);
+    v[0] = std::make_unique<int>(1);
+    v[1] = std::make_unique<int>(2);
+    v.Clear();
+    REQUIRE(v.Size() == 0u);
+    REQUIRE(v.Empty());
+  }
+}
+
+TEST_CASE("Resize", "[ReallocationStrategy]") {
+  {
+    Static<std::unique_ptr<int>> v;
+    v.Resize(5u);
+    Equal(v, std::vector<std::unique_ptr<int>>(5u));
+  }
+
+  {
+    Static<int> v;
+    v.Resize(5u, 11);
+    Equal(v, std::vector<int>(5u, 11));
+  }
+
+  {
+    Static<std::unique_ptr<int>> v(100);
+    for (int i = 0; i < 100; ++i) {
+      v[i] = std::make_unique<int>(i);
+    }
+    v.Resize(1000);
+
+    REQUIRE(v.Size() == 1000u);
+    for (int i = 0; i < 100; ++i) {
+      REQUIRE(*v[i] == i);
+    }
+    for (int i = 100; i < 1000; ++i) {
+      REQUIRE(v[i] == nullptr);
+    }
+  }
+
+  {
+    Static<int> v(1000u, 11);
+    const auto pv = v.Data();
+
+    v.Resize(400u, -1);
+    Equal(v, std::vector<int>(400u, 11));
+
+    v.Resize(100u);
+    Equal(v, std::vector<int>(100u, 11));
+
+    v.Resize(500u, -11);
+    for (int i = 0; i < 100; ++i) {
+      REQUIRE(v[i] == 11);
+    }
+    for (int i = 100; i < 500; ++i) {
+      REQUIRE(v[i] == -11);
+    }
+    REQUIRE(v.Size() == 500u);
+    REQUIRE(pv == v.Data());
+
+    REQUIRE_THROWS_AS(v.Resize(1025u), StaticVectorOverflow);  // NOLINT
+    REQUIRE(v.Size() == 500u);
+  }
+}
+
+TEST_CASE("Reserve And ShrinkToFit", "[ReallocationStrategy]") {
+  Static<int> v(10u, 5);
+  const auto pv = v.Data();
+
+  v.Reserve(1024u);
+  v.ShrinkToFit();
+  Equal(v, std::vector<int>(10u, 5));
+  REQUIRE(v.Capacity() == 1024u);
+  REQUIRE(pv == v.Data());
+
+  REQUIRE_THROWS_AS(v.Reserve(1025u), StaticVectorOverflow);  // NOLINT
+}
+
+TEST_CASE("PushBack", "[ReallocationStrategy]") {
+  {
+    Static<std::unique_ptr<int>> v;
+    for (int i = 0; i < 100; ++i) {
+      v.PushBack(std::make_unique<int>(i));
+      REQUIRE(v.Size() == static_cast<unsigned>(i + 1));
+    }
+    for (int i = 0; i < 100; ++i) {
+      REQUIRE(*v[i] == i);
+    }
+  }
+
+  {
+    StaticVector<int, 10> v(10u);
+    REQUIRE_THROWS_AS(v.PushBack(1), StaticVectorOverflow);  // NOLINT
+    REQUIRE(v.Size() == 10u);
+  }
+
+  {
+    StaticVector<int, 10, OverflowUnchecked> v;
+    for (int i = 0; i < 10; ++i) {
+      v.PushBack(i);
+    }
+    Equal(v, std::vector<int>{0, 1, 2, 3, 4, 5, 6, 7, 8, 9});
+  }
+}
+
+TEST_CASE("PopBack", "[ReallocationStrategy]") {
+  Static<std::unique_ptr<int>> v;
+  for (int i = 0; i < 100; ++i) {
+    v.PushBack(std::make_unique<int>(i));
+  }
+  for (int i = 0; i < 50; ++i) {
+    v.PopBack();
+    REQUIRE(v.Size() == static_cast<unsigned>(100 - i - 1));
+  }
+  for (int i = 0; i < 50; ++i) {
+    REQUIRE(*v[i] == i);
+  }
+}
+
+TEST_CASE("Stress", "[ReallocationStrategy]") {
+  auto v = std::make_unique<StaticVector<std::unique_ptr<int>, 1'000'000>>();
+  for (int i = 0; i < 1'000'000; ++i) {
+    v->PushBack(std::make_unique<int>(i));
+    REQUIRE(v->Size() == static_cast<unsigned>(i + 1));
+  }
+  REQUIRE_THROWS_AS(v->PushBack(nullptr), StaticVectorOverflow);  // NOLINT
+  for (int i = 0; i < 500'000; ++i) {
+    v->PopBack();
+    REQUIRE(v->Size() == static_cast<unsigned>(1'000'000 - i - 1));
+  }
+  for (int i = 0; i < 500'000; ++i) {
+    REQUIRE(*(*v)[i] == i);
+  }
+}
+
+template <class T>
+void CheckComparisonEqual(const Static<T>& lhs, const Static<T>& rhs) {
+  REQUIRE(lhs == rhs);
+  REQUIRE(lhs <= rhs);
+  REQUIRE(lhs >= rhs);
+  REQUIRE_FALSE(lhs != rhs);
+  REQUIRE_FALSE(lhs < rhs);
+  REQUIRE_FALSE(lhs > rhs);
+}
+
+template <class T>
+void CheckComparisonLess(const Static<T>& lhs, const Static<T>& rhs) {
+  REQUIRE_FALSE(lhs == rhs);
+  REQUIRE(lhs <= rhs);
+  REQUIRE_FALSE(lhs >= rhs);
+  REQUIRE(lhs != rhs);
+  REQUIRE(lhs < rhs);
+  REQUIRE_FALSE(lhs > rhs);
+}
+
+template <class T>
+void CheckComparisonGreater(const Static<T>& lhs, const Static<T>& rhs) {
+  REQUIRE_FALSE(lhs == rhs);
+  REQUIRE_FALSE(lhs <= rhs);
+  REQUIRE(lhs >= rhs);
+  REQUIRE(lhs != rhs);
+  REQUIRE_FALSE(lhs < rhs);
+  REQUIRE(lhs > rhs);
+}
+
+TEST_CASE("Comparisons", "[StaticVector]") {
+  {
+    Static<int> a;
+    Static<int> b;
+    CheckComparisonEqual(a, b);
+  }
+
+  {
+    Static<int> a;
+    Static<int> b(1, 2);
+    CheckComparisonLess(a, b);
+    CheckComparisonGreater(b, a);
+  }
+
+  {
+    Static<int> a{1, 3};
+    Static<int> b{2};
+    CheckComparisonLess(a, b);
+    CheckComparisonGreater(b, a);
+  }
+
+  {
+    Static<int> a{1, 2, 3};
+    Static<int> b{1, 1};
+    CheckComparisonLess(b, a);
+    CheckComparisonGreater(a, b);
+  }
+
+  {
+    Static<int> a{1, 2, 3, 4};
+    Static<int> b{1, 2, 3, 4};
+    CheckComparisonEqual(a, b);
+  }
+
+  {
+    Static<int> a{1, 2, 3, 4};
+    Static<int> b{1, 2, 3};
+    CheckComparisonLess(b, a);
+    CheckComparisonGreater(a, b);
+  }
+
+  {
+    Static<int> a{1, 4, 6, 8};
+    Static<int> b{2, 3, 5, 7};
+    CheckComparisonLess(a, b);
+    CheckComparisonGreater(b, a);
+  }
+
+  {
+    Static<int> a{1, 2, 3, 5};
+    Static<int> b{1, 2, 4, 5};
+    CheckComparisonLess(a, b);
+    CheckComparisonGreater(b, a);
+  }
+}
+
+TEST_CASE("Iterator", "[Iterators]") {
+  {
+    using Iterator = Static<int>::Iterator;
+    REQUIRE((std::is_same_v<Iterator, decltype(std::declval<Static<int>>().begin())>));
+    REQUIRE((std::is_same_v<Iterator, decltype(std::declval<Static<int>>().end())>));
+
+    using Traits = std::iterator_traits<Iterator>;
+    REQUIRE((std::is_same_v<Traits::value_type, int>));
+    REQUIRE((std::is_same_v<Traits::reference, decltype(*std::declval<Iterator>())>));
+    REQUIRE((std::is_base_of_v<std::random_access_iterator_tag, Traits::iterator_category>));
+  }
+
+  {
+    Static<int> v(10u);
+    int i = 0;
+    for (auto& x : v) {
+      x = ++i;
+    }
+    i = 0;
+    for (auto& x : v) {
+      REQUIRE(x == ++i);
+    }
+  }
+
+  {
+    Static<int> v(10u, -1);
+    std::fill(v.begin() + 5, v.end(), 1);
+    for (int i = 0; i < 5; ++i) {
+      REQUIRE(v[i] == -1);
+    }
+    for (int i = 5; i < 10; ++i) {
+      REQUIRE(v[i] == 1);
+    }
+  }
+}
+
+TEST_CASE("ConstIterator", "[Iterators]") {
+  {
+    using ConstIterator = Static<int>::ConstIterator;
+    REQUIRE((std::is_same_v<ConstIterator, decltype(std::declval<Static<int>>().cbegin())>));
+    REQUIRE((std::is_same_v<ConstIterator, decltype(std::declval<Static<int>>().cend())>));
+    REQUIRE((std::is_same_v<ConstIterator, decltype(std::declval<const Static<int>>().begin())>));
+    REQUIRE((std::is_same_v<ConstIterator, decltype(std::declval<const Static<int>>().end())>));
+  }
+
+  {
+    Static<int> v(10u);
+    int i = 0;
+    for (auto& x : v) {
+      x = ++i;
+    }
+
+    i = 0;
+    for (auto& x : std::as_const(v)) {
+      REQUIRE(x == ++i);
+    }
+
+    i = 0;
+    for (auto it = v.cbegin(); it != v.cend(); ++it) {
+      REQUIRE(*it == ++i);
+    }
+  }
+}
+
+TEST_CASE("ReverseIterator", "[Iterators]") {
+  {
+    using ReverseIterator = Static<int>::ReverseIterator;
+    REQUIRE((std::is_same_v<ReverseIterator, decltype(std::declval<Static<int>>().rbegin())>));
+    REQUIRE((std::is_same_v<ReverseIterator, decltype(std::declval<Static<int>>().rend())>));
+    REQUIRE((std::is_same_v<ReverseIterator, std::reverse_iterator<Static<int>::Iterator>>));
+  }
+
+  {
+    Static<int> v(10u);
+    int i = 0;
+    for (auto it = v.rbegin(); it != v.rend(); ++it) {
+      *it = ++i;
+    }
+    i = 11;
+    for (auto& x : v) {
+      REQUIRE(x == --i);
+    }
+
+    i = 0;
+    for (auto it = v.crbegin(); it != v.crend(); ++it) {
+      REQUIRE(*it == ++i);
+    }
+  }
+}
+
+class Exception {};
+
+class Throwable {
+  std::unique_ptr<int> p_ = std::make_unique<int>();  // check d-tor is called
+
+ public:
+  static int until_throw;
+
+  Throwable() {
+    --until_throw;
+    if (until_throw <= 0) {
+      throw Exception{};
+    }
+  }
+
+  Throwable(const Throwable&) : Throwable() {
+  }
+
+  Throwable(Throwable&&) noexcept = default;
+
+  Throwable& operator=(const Throwable&) {
+    --until_throw;
+    if (until_throw <= 0) {
+      throw Exception{};
+    }
+    return *this;
+  }
+
+  Throwable& operator=(Throwable&&) noexcept = default;
+};
+
+int Throwable::until_throw = 0;
+
+TEST_CASE("Size Constructor", "[Safety]") {
+  Throwable::until_throw = 5;
+  REQUIRE_THROWS_AS(Static<Throwable>(10u), Exception);  // NOLINT
+}
+
+TEST_CASE("Value Constructor", "[Safety]") {
+  Throwable::until_throw = 5;
+  REQUIRE_THROWS_AS(Static<Throwable>(10u, Throwable{}), Exception);  // NOLINT
+}
+
+TEST_CASE("Iterators Constructor", "[Safety]") {
+  Throwable::until_throw = 210;
+  const std::vector<Throwable> values(100u, Throwable{});
+  Throwable::until_throw = 50;
+  REQUIRE_THROWS_AS(Static<Throwable>(values.begin(), values.end()), Exception);  // NOLINT
+}
+
+TEST_CASE("Copy Constructor Safety", "[Safety]") {
+  Throwable::until_throw = 210;
+  const Static<Throwable> values(100u, Throwable{});
+  Throwable::until_throw = 50;
+  REQUIRE_THROWS_AS(Static<Throwable>(values), Exception);  // NOLINT
+}
+
+TEST_CASE("Move Safety", "[Safety]") {
+  Throwable::until_throw = 210;
+  Static<Throwable> values(100u, Throwable{});
+  Static<Throwable> v(10u);
+  Throwable::until_throw = 1;
+  REQUIRE_NOTHROW(Static<Throwable>(std::move(values)));  // NOLINT
+  REQUIRE_NOTHROW(v = Static<Throwable>());               // NOLINT
+  REQUIRE_NOTHROW(v.Swap(values));                        // NOLINT
+}
+
+TEST_CASE("Copy Assignment Safety", "[Safety]") {
+  Throwable::until_throw = 100;
+  const Static<Throwable> values(10u);
+  Static<Throwable> v(35u);
+  Throwable::until_throw = 5;
+  REQUIRE_THROWS_AS(v = values, Exception);  // NOLINT
+  REQUIRE(v.Size() <= v.Capacity());
+}
+
+TEST_CASE("Resize Safety", "[Safety]") {
+  Throwable::until_throw = 200;
+  Static<Throwable> v(90u);
+
+  REQUIRE_NOTHROW(v.Resize(90u));  // NOLINT
+  REQUIRE_NOTHROW(v.Resize(50u));  // NOLINT
+  REQUIRE_NOTHROW(v.Resize(10u));  // NOLINT
+
+  Throwable::until_throw = 10;
+  REQUIRE_THROWS_AS(v.Resize(200u), Exception);  // NOLINT
+  REQUIRE(v.Size() == 10u);
+}
+
+TEST_CASE("PushBack Safety", "[Safety]") {
+  Throwable::until_throw = 200;
+  StaticVector<Throwable, 100> v;
+  Throwable::until_throw = 101;
+  for (size_t i = 0; i < 99; ++i) {
+    v.PushBack({});
+  }
+  const Throwable object;
+  REQUIRE_THROWS_AS(v.PushBack(object), Exception);  // NOLINT
+  REQUIRE(v.Size() == 99u);
+
+  Throwable::until_throw = 10;
+  v.PushBack(object);
+  REQUIRE_THROWS_AS(v.PushBack(object), StaticVectorOverflow);  // NOLINT
+  REQUIRE(v.Size() == 100u);
+}
+
+#ifdef VECTOR_MEMORY_IMPLEMENTED
+
+struct InstanceCounter {
+  static size_t counter;
+
+  InstanceCounter() noexcept {
+    ++counter;
+  }
+
+  InstanceCounter(const InstanceCounter&) : InstanceCounter() {
+  }
+
+  InstanceCounter(InstanceCounter&&) : InstanceCounter() {
+  }
+
+  InstanceCounter& operator=(const InstanceCounter&) = default;
+  InstanceCounter& operator=(InstanceCounter&&) noexcept = default;
+
+  ~InstanceCounter() {
+    --counter;
+  }
+};
+
+size_t InstanceCounter::counter = 0u;
+
+TEST_CASE("ConstructorsAndDestructors", "[Memory]") {
+  InstanceCounter::counter = 0u;
+
+  SECTION("Default Constructor") {
+    const Static<InstanceCounter> v;
+    REQUIRE(InstanceCounter::counter == 0u);
+  }
+
+  SECTION("Size Constructor") {
+    const Static<InstanceCounter> v(10u);
+    REQUIRE(InstanceCounter::counter == 10u);
+  }
+
+  SECTION("Iterators Constructor") {
+    const std::vector<InstanceCounter> values(100u);
+    const Static<InstanceCounter> v(values.begin(), values.end());
+    REQUIRE(InstanceCounter::counter == 200u);
+  }
+
+  SECTION("Copy Constructor") {
+    const Static<InstanceCounter> values(100u);
+    const auto v = values;
+    REQUIRE(InstanceCounter::counter == 200u);
+  }
+
+  SECTION("Move Constructor") {
+    Static<InstanceCounter> values(100u);
+    const auto v = std::move(values);
+    REQUIRE(InstanceCounter::counter == 100u);
+  }
+
+  REQUIRE(InstanceCounter::counter == 0u);
+}
+
+TEST_CASE("Assignment Memory", "[Memory]") {
+  InstanceCounter::counter = 0u;
+
+  {
+    const Static<InstanceCounter> values(10u);
+    Static<InstanceCounter> v(100u);
+    v = values;
+    REQUIRE(InstanceCounter::counter == 20u);
+  }
+  REQUIRE(InstanceCounter::counter == 0u);
+
+  {
+    Static<InstanceCounter> values(100u);
+    Static<InstanceCounter> v(10u);
+    v = std::move(values);
+    REQUIRE(InstanceCounter::counter == 100u);
+  }
+  REQUIRE(InstanceCounter::counter == 0u);
+
+  {
+    Static<InstanceCounter> a(20u);
+    Static<InstanceCounter> b(10u);
+    a.Swap(b);
+    REQUIRE(InstanceCounter::counter == 30u);
+  }
+  REQUIRE(InstanceCounter::counter == 0u);
+}
+
+TEST_CASE("Resize Memory", "[Memory]") {
+  InstanceCounter::counter = 0u;
+
+  {
+    Static<InstanceCounter> v;
+    v.Resize(100u);
+    REQUIRE(InstanceCounter::counter == 100u);
+    v.Resize(10u, InstanceCounter{});
+    REQUIRE(InstanceCounter::counter == 10u);
+    v.Resize(1000u);
+    REQUIRE(InstanceCounter::counter == 1000u);
+    v.PopBack();
+    REQUIRE(InstanceCounter::counter == 999u);
+    v.Clear();
+    REQUIRE(InstanceCounter::counter == 0u);
+    v.EmplaceBack();
+    REQUIRE(InstanceCounter::counter == 1u);
+  }
+  REQUIRE(InstanceCounter::counter == 0u);
+}
+
+#endif
@@ -1,13 +1,19 @@
 #pragma once
 
 #include <algorithm>
+#include <cstring>
 #include <exception>
+#include <functional>
 #include <initializer_list>
 #include <iterator>
 #include <memory>
 #include <stdexcept>
+#include <type_traits>
 #include <utility>
 
+#include "mismatch.h"
+#include "vector_trace.h"
+
 #define VECTOR_MEMORY_IMPLEMENTED
 
 class ArrayOutOfRange : public std::out_of_range {
@@ -16,9 +22,59 @@ class ArrayOutOfRange : public std::out_of_range {
   }
 };
 
+// Keeps a rarely taken path out of its callers.
+#if defined(__GNUC__)
+#define VECTOR_NOINLINE __attribute__((noinline, cold))
+#elif defined(_MSC_VER)
+#define VECTOR_NOINLINE __declspec(noinline)
+#else
+#define VECTOR_NOINLINE
+#endif
+
+// Types whose objects can be moved to a new address with memcpy, leaving nothing to destroy at the old one.
+// Trivially copyable types qualify automatically; other types may opt in by specializing this trait.
+template <typename T>
+struct IsTriviallyRelocatable : std::is_trivially_copyable<T> {};
+
 template <typename T>
-class Vector {
+inline constexpr bool kIsTriviallyRelocatable = IsTriviallyRelocatable<T>::value;
+
+// Moves [first, last) into uninitialized memory at dest and ends the lifetime of the source objects.
+template <typename T>
+void UninitializedRelocate(T* first, T* last, T* dest) {
+  if constexpr (kIsTriviallyRelocatable<T>) {
+    if (first != last) {
+      std::memcpy(static_cast<void*>(dest), static_cast<const void*>(first), (last - first) * sizeof(T));
+    }
+  } else {
+    std::uninitialized_move(first, last, dest);
+    std::destroy(first, last);
+  }
+}
+
+struct GrowthFactorTwo {
+  static size_t NextCapacity(size_t capacity) {
+    return capacity == 0 ? 1 : capacity * 2;
+  }
+};
+
+struct GrowthFactorOneAndHalf {
+  static size_t NextCapacity(size_t capacity) {
+    return capacity < 2 ? capacity + 1 : capacity + capacity / 2;
+  }
+};
+
+// Allocator only supplies raw storage; elements are constructed and destroyed in place by Vector itself.
+// It is held as a private base so that stateless allocators take no space.
+template <typename T, typename GrowthPolicy = GrowthFactorTwo, typename Allocator = std::allocator<T>>
+class Vector : private Allocator {
+  using AllocatorTraits = std::allocator_traits<Allocator>;
+
+  static constexpr bool kMoveAssignSteals = AllocatorTraits::propagate_on_container_move_assignment::value ||
+                                            AllocatorTraits::is_always_equal::value;
+
  public:
+  using AllocatorType = Allocator;
   using ValueType = T;
   using Pointer = T*;
   using ConstPointer = const T*;
@@ -34,14 +90,18 @@ class Vector {
   Vector() : data_(nullptr), size_(0), capacity_(0) {
   }
 
-  explicit Vector(SizeType size) : data_(nullptr), size_(0), capacity_(size) {
+  explicit Vector(const Allocator& allocator) : Allocator(allocator), data_(nullptr), size_(0), capacity_(0) {
+  }
+
+  explicit Vector(SizeType size, const Allocator& allocator = Allocator())
+      : Allocator(allocator), data_(nullptr), size_(0), capacity_(size) {
     if (size > 0) {
-      data_ = static_cast<T*>(::operator new(size * sizeof(T)));
+      data_ = Allocate(size);
       try {
         std::uninitialized_value_construct_n(data_, size);
         size_ = size;
       } catch (...) {
-        Dealloc(data_);
+        Dealloc(data_, capacity_);
         data_ = nullptr;
         capacity_ = 0;
         throw;
@@ -49,14 +109,15 @@ class Vector {
     }
   }
 
-  Vector(SizeType size, const T& value) : data_(nullptr), size_(0), capacity_(size) {
+  Vector(SizeType size, const T& value, const Allocator& allocator = Allocator())
+      : Allocator(allocator), data_(nullptr), size_(0), capacity_(size) {
     if (size > 0) {
-      data_ = static_cast<T*>(operator new(size * sizeof(T)));
+      data_ = Allocate(size);
       try {
         std::uninitialized_fill_n(data_, size, value);
         size_ = size;
       } catch (...) {
-        Dealloc(data_);
+        Dealloc(data_, capacity_);
         data_ = nullptr;
         capacity_ = 0;
         throw;
@@ -67,14 +128,15 @@ class Vector {
   template <class InputIterator,
             class = std::enable_if_t<std::is_base_of_v<
                 std::input_iterator_tag, typename std::iterator_traits<InputIterator>::iterator_category>>>
-  Vector(InputIterator first, InputIterator last) : data_(nullptr), size_(0), capacity_(std::distance(first, last)) {
+  Vector(InputIterator first, InputIterator last, const Allocator& allocator = Allocator())
+      : Allocator(allocator), data_(nullptr), size_(0), capacity_(std::distance(first, last)) {
     if (capacity_ > 0) {
-      data_ = static_cast<T*>(operator new(capacity_ * sizeof(T)));
+      data_ = Allocate(capacity_);
       try {
         std::uninitialized_copy(first, last, data_);
         size_ = capacity_;
       } catch (...) {
-        Dealloc(data_);
+        Dealloc(data_, capacity_);
         data_ = nullptr;
         capacity_ = 0;
         throw;
@@ -82,18 +144,24 @@ class Vector {
     }
   }
 
-  Vector(std::initializer_list<T> init) : Vector(init.begin(), init.end()) {
+  Vector(std::initializer_list<T> init, const Allocator& allocator = Allocator())
+      : Vector(init.begin(), init.end(), allocator) {
+  }
+
+  Vector(const Vector& other)
+      : Vector(other, AllocatorTraits::select_on_container_copy_construction(other.AllocatorRef())) {
   }
 
-  Vector(const Vector& other) : data_(nullptr), size_(0), capacity_(0) {
+  Vector(const Vector& other, const Allocator& allocator)
+      : Allocator(allocator), data_(nullptr), size_(0), capacity_(0) {
     if (other.size_ > 0) {
-      data_ = static_cast<T*>(operator new(other.capacity_ * sizeof(T)));
+      data_ = Allocate(other.capacity_);
       try {
         std::uninitialized_copy(other.data_, other.data_ + other.size_, data_);
         size_ = other.size_;
         capacity_ = other.capacity_;
       } catch (...) {
-        Dealloc(data_);
+        Dealloc(data_, other.capacity_);
         data_ = nullptr;
         capacity_ = 0;
         throw;
@@ -101,7 +169,11 @@ class Vector {
     }
   }
 
-  Vector(Vector&& other) noexcept : data_(other.data_), size_(other.size_), capacity_(other.capacity_) {
+  Vector(Vector&& other) noexcept
+      : Allocator(std::move(other.AllocatorRef()))
+      , data_(other.data_)
+      , size_(other.size_)
+      , capacity_(other.capacity_) {
     other.data_ = nullptr;
     other.size_ = 0;
     other.capacity_ = 0;
@@ -109,37 +181,35 @@ class Vector {
 
   Vector& operator=(const Vector& other) {
     if (this != &other) {
-      if (other.size_ == 0) {
-        Clear();
-        Dealloc(data_);
-        data_ = nullptr;
-        size_ = 0;
-        capacity_ = 0;
-      } else {
-        Vector tmp(other);
-        Swap(tmp);
-      }
+      constexpr bool kPropagate = AllocatorTraits::propagate_on_container_copy_assignment::value;
+      Vector tmp(other, kPropagate ? other.AllocatorRef() : AllocatorRef());
+      Release();
+      StealFrom(tmp);
     }
     return *this;
   }
 
-  Vector& operator=(Vector&& other) noexcept {
+  Vector& operator=(Vector&& other) noexcept(kMoveAssignSteals) {
     if (this != &other) {
-      Clear();
-      Dealloc(data_);
-      data_ = other.data_;
-      size_ = other.size_;
-      capacity_ = other.capacity_;
-      other.data_ = nullptr;
-      other.size_ = 0;
-      other.capacity_ = 0;
+      if (kMoveAssignSteals || AllocatorRef() == other.AllocatorRef()) {
+        Release();
+        StealFrom(other);
+      } else {
+        Vector tmp(std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()), AllocatorRef());
+        Release();
+        StealFrom(tmp);
+      }
     }
     return *this;
   }
 
   ~Vector() {
-    Clear();
-    Dealloc(data_);
+    VectorTrace::OnDestroy<T>(capacity_ * sizeof(T), (capacity_ - size_) * sizeof(T));
+    Release();
+  }
+
+  Allocator GetAllocator() const {
+    return AllocatorRef();
   }
 
   SizeType Size() const {
@@ -201,36 +271,22 @@ class Vector {
   }
 
   void Swap(Vector& other) noexcept {
+    if constexpr (AllocatorTraits::propagate_on_container_swap::value) {
+      std::swap(AllocatorRef(), other.AllocatorRef());
+    }
     std::swap(data_, other.data_);
     std::swap(size_, other.size_);
     std::swap(capacity_, other.capacity_);
   }
 
   void Resize(SizeType new_size) {
+    if (new_size > capacity_) {
+      ReallocateAndConstruct(new_size, new_size - size_,
+                             [&](Pointer p) { std::uninitialized_value_construct_n(p, new_size - size_); });
+      return;
+    }
     if (new_size > size_) {
-      if (new_size > capacity_) {
-        SizeType new_capacity = new_size;
-        T* new_data = static_cast<T*>(operator new(new_capacity * sizeof(T)));
-        try {
-          std::uninitialized_move(data_, data_ + size_, new_data);
-          std::uninitialized_value_construct_n(new_data + size_, new_size - size_);
-        } catch (...) {
-          std::destroy(new_data, new_data + size_);
-          operator delete(new_data);
-          throw;
-        }
-        std::destroy(data_, data_ + size_);
-        operator delete(data_);
-        data_ = new_data;
-        capacity_ = new_capacity;
-      } else {
-        try {
-          std::uninitialized_value_construct_n(data_ + size_, new_size - size_);
-        } catch (...) {
-          std::destroy(data_ + size_, data_ + new_size);
-          throw;
-        }
-      }
+      std::uninitialized_value_construct_n(data_ + size_, new_size - size_);
     } else {
       std::destroy(data_ + new_size, data_ + size_);
     }
@@ -238,73 +294,54 @@ class Vector {
   }
 
   void Resize(SizeType new_size, const T& value) {
+    if (new_size > capacity_) {
+      ReallocateAndConstruct(new_size, new_size - size_,
+                             [&](Pointer p) { std::uninitialized_fill_n(p, new_size - size_, value); });
+      return;
+    }
     if (new_size > size_) {
-      if (new_size > capacity_) {
-        T* new_data = nullptr;
-        SizeType old_capacity = capacity_;
-        try {
-          new_data = static_cast<T*>(operator new(new_size * sizeof(T)));
-          std::uninitialized_move(data_, data_ + size_, new_data);
-          std::uninitialized_fill_n(new_data + size_, new_size - size_, value);
-          std::destroy(data_, data_ + size_);
-          Dealloc(data_);
-          data_ = new_data;
-          capacity_ = new_size;
-        } catch (...) {
-          if (new_data) {
-            std::destroy(new_data, new_data + size_);
-            Dealloc(new_data);
-          }
-          capacity_ = old_capacity;
-          throw;
-        }
-      } else {
-        try {
-          std::uninitialized_fill_n(data_ + size_, new_size - size_, value);
-        } catch (...) {
-          std::destroy(data_ + size_, data_ + new_size);
-          throw;
-        }
-      }
+      std::uninitialized_fill_n(data_ + size_, new_size - size_, value);
     } else {
       std::destroy(data_ + new_size, data_ + size_);
     }
     size_ = new_size;
   }
 
+  // Like Resize, but new elements are default-initialized: trivial types are left with indeterminate values
+  // instead of being zeroed, so a freshly grown buffer is not written before the caller fills it.
+  void ResizeDefaultInit(SizeType new_size) {
+    if (new_size > capacity_) {
+      ReallocateAndConstruct(new_size, new_size - size_,
+                             [&](Pointer p) { std::uninitialized_default_construct_n(p, new_size - size_); });
+      return;
+    }
+    if (new_size > size_) {
+      std::uninitialized_default_construct_n(data_ + size_, new_size - size_);
+    } else {
+      std::destroy(data_ + new_size, data_ + size_);
+    }
+    size_ = new_size;
+  }
+
+  void ResizeUninitialized(SizeType new_size) {
+    static_assert(std::is_trivially_default_constructible_v<T> && std::is_trivially_destructible_v<T>,
+                  "ResizeUninitialized requires a trivial element type, use ResizeDefaultInit instead");
+    ResizeDefaultInit(new_size);
+  }
+
   void Reserve(SizeType new_cap) {
     if (new_cap > capacity_) {
-      T* new_data = static_cast<T*>(operator new(new_cap * sizeof(T)));
-      try {
-        std::uninitialized_move(data_, data_ + size_, new_data);
-      } catch (...) {
-        Dealloc(new_data);
-        throw;
-      }
-      std::destroy(data_, data_ + size_);
-      Dealloc(data_);
-      data_ = new_data;
-      capacity_ = new_cap;
+      Reallocate(new_cap);
     }
   }
 
   void ShrinkToFit() {
     if (size_ == 0) {
-      Dealloc(data_);
+      Dealloc(data_, capacity_);
       data_ = nullptr;
       capacity_ = 0;
     } else if (capacity_ > size_) {
-      T* new_data = static_cast<T*>(operator new(size_ * sizeof(T)));
-      try {
-        std::uninitialized_move(data_, data_ + size_, new_data);
-      } catch (...) {
-        Dealloc(new_data);
-        throw;
-      }
-      std::destroy(data_, data_ + size_);
-      Dealloc(data_);
-      data_ = new_data;
-      capacity_ = size_;
+      Reallocate(size_);
     }
   }
 
@@ -314,69 +351,81 @@ class Vector {
   }
 
   void PushBack(const T& value) {
+    EmplaceBack(value);
+  }
+
+  void PushBack(T&& value) {
+    EmplaceBack(std::move(value));
+  }
+
+  template <typename... Args>
+  void EmplaceBack(Args&&... args) {
     if (size_ == capacity_) {
-      SizeType new_capacity = capacity_ == 0 ? 1 : capacity_ * 2;
-      T* new_data = static_cast<T*>(operator new(new_capacity * sizeof(T)));
-      try {
-        std::uninitialized_move(data_, data_ + size_, new_data);
-        new (new_data + size_) T(value);
-      } catch (...) {
-        std::destroy(new_data, new_data + size_);
-        operator delete(new_data);
-        throw;
-      }
-      std::destroy(data_, data_ + size_);
-      operator delete(data_);
-      data_ = new_data;
-      capacity_ = new_capacity;
-    } else {
-      try {
-        new (data_ + size_) T(value);
-      } catch (...) {
-        throw;
-      }
+      // the new element is built before relocation, so args may refer into *this
+      ReallocateAndConstruct(GrowthPolicy::NextCapacity(capacity_), 1,
+                             [&](Pointer p) { new (p) T(std::forward<Args>(args)...); });
+      return;
     }
+    new (data_ + size_) T(std::forward<Args>(args)...);
     ++size_;
   }
 
-  void PushBack(T&& value) {
-    if (size_ == capacity_) {
-      SizeType new_capacity = capacity_ == 0 ? 1 : capacity_ * 2;
-      T* new_data = static_cast<T*>(operator new(new_capacity * sizeof(T)));
-      try {
-        std::uninitialized_move(data_, data_ + size_, new_data);
-        new (new_data + size_) T(std::move(value));
-      } catch (...) {
-        std::destroy(new_data, new_data + size_);
-        operator delete(new_data);
-        throw;
-      }
-      std::destroy(data_, data_ + size_);
-      operator delete(data_);
-      data_ = new_data;
-      capacity_ = new_capacity;
+  template <class InputIterator,
+            class = std::enable_if_t<std::is_base_of_v<
+                std::input_iterator_tag, typename std::iterator_traits<InputIterator>::iterator_category>>>
+  Iterator Insert(ConstIterator pos, InputIterator first, InputIterator last) {
+    SizeType position = pos - data_;
+    using Category = typename std::iterator_traits<InputIterator>::iterator_category;
+    if constexpr (std::is_base_of_v<std::forward_iterator_tag, Category>) {
+      SizeType count = std::distance(first, last);
+      InsertConstructed(position, count, [&](Pointer p) { std::uninitialized_copy(first, last, p); });
     } else {
-      try {
-        new (data_ + size_) T(std::move(value));
-      } catch (...) {
-        throw;
+      SizeType old_size = size_;
+      for (; first != last; ++first) {
+        EmplaceBack(*first);
       }
+      std::rotate(data_ + position, data_ + old_size, data_ + size_);
     }
-    ++size_;
+    return data_ + position;
   }
 
-  template <typename... Args>
-  void EmplaceBack(Args&&... args) {
-    if (size_ == capacity_) {
-      Reserve(capacity_ == 0 ? 1 : capacity_ * 2);
+  Iterator Insert(ConstIterator pos, SizeType count, const T& value) {
+    SizeType position = pos - data_;
+    if (std::less_equal<ConstPointer>()(data_, std::addressof(value)) &&
+        std::less<ConstPointer>()(std::addressof(value), data_ + size_)) {
+      T copy(value);
+      InsertConstructed(position, count, [&](Pointer p) { std::uninitialized_fill_n(p, count, copy); });
+    } else {
+      InsertConstructed(position, count, [&](Pointer p) { std::uninitialized_fill_n(p, count, value); });
     }
-    try {
-      new (data_ + size_) T(std::forward<Args>(args)...);
-      ++size_;
-    } catch (...) {
-      std::destroy_at(data_ + size_);
-      throw;
+    return data_ + position;
+  }
+
+  template <class InputIterator,
+            class = std::enable_if_t<std::is_base_of_v<
+                std::input_iterator_tag, typename std::iterator_traits<InputIterator>::iterator_category>>>
+  void Append(InputIterator first, InputIterator last) {
+    Insert(end(), first, last);
+  }
+
+  Iterator Erase(ConstIterator first, ConstIterator last) {
+    Pointer from = data_ + (first - data_);
+    Pointer to = data_ + (last - data_);
+    if (from != to) {
+      if constexpr (kIsTriviallyRelocatable<T>) {
+        std::destroy(from, to);
+        std::memmove(static_cast<void*>(from), static_cast<const void*>(to), (end() - to) * sizeof(T));
+      } else {
+        Pointer new_end = std::move(to, end(), from);
+        std::destroy(new_end, end());
+      }
+      size_ -= to - from;
     }
+    return from;
+  }
+
+  Iterator Erase(ConstIterator pos) {
+    return Erase(pos, pos + 1);
   }
 
   void PopBack() {
@@ -387,15 +436,15 @@ class Vector {
   }
 
   friend bool operator==(const Vector& l_value, const Vector& r_value) {
-    return l_value.size_ == r_value.size_ && std::equal(l_value.data_, l_value.data_ + l_value.size_, r_value.data_);
+    return l_value.size_ == r_value.size_ && RangesEqual(l_value.data_, r_value.data_, l_value.size_);
   }
-  
+
   friend bool operator!=(const Vector& l_value, const Vector& r_value) {
     return !(l_value == r_value);
   }
 
   friend bool operator<(const Vector& l_value, const Vector& r_value) {
-    return std::lexicographical_compare(l_value.data_, l_value.data_ + l_value.size_, r_value.data_, r_value.data_ + r_value.size_);
+    return RangesLess(l_value.data_, l_value.size_, r_value.data_, r_value.size_);
   }
 
   friend bool operator>(const Vector& l_value, const Vector& r_value) {
@@ -463,9 +512,116 @@ class Vector {
   SizeType size_;
   SizeType capacity_;
 
-  static void Dealloc(Pointer p) {
+  Allocator& AllocatorRef() noexcept {
+    return *this;
+  }
+
+  const Allocator& AllocatorRef() const noexcept {
+    return *this;
+  }
+
+  Pointer Allocate(SizeType n) {
+    return AllocatorTraits::allocate(AllocatorRef(), n);
+  }
+
+  void Dealloc(Pointer p, SizeType n) {
     if (p != nullptr) {
-      operator delete(p);
+      AllocatorTraits::deallocate(AllocatorRef(), p, n);
+    }
+  }
+
+  void Release() noexcept {
+    Clear();
+    Dealloc(data_, capacity_);
+    data_ = nullptr;
+    capacity_ = 0;
+  }
+
+  // Takes over other's buffer and allocator; the caller has already released ours.
+  void StealFrom(Vector& other) noexcept {
+    AllocatorRef() = std::move(other.AllocatorRef());
+    data_ = other.data_;
+    size_ = other.size_;
+    capacity_ = other.capacity_;
+    other.data_ = nullptr;
+    other.size_ = 0;
+    other.capacity_ = 0;
+  }
+
+  // Moves the storage to a fresh buffer of new_capacity, letting construct(p) first build count new elements
+  // at p == new_data + position; the old elements before and after position are relocated around them.
+  // Either the whole operation succeeds or *this is left untouched. Kept out of line: it runs once per growth, and
+  // inlined into a caller whose sizes are known it draws false -Warray-bounds reports on the branch not taken.
+  template <typename Construct>
+  VECTOR_NOINLINE void ReallocateAndInsert(SizeType new_capacity, SizeType position, SizeType count, Construct construct) {
+    Pointer new_data = Allocate(new_capacity);
+    try {
+      construct(new_data + position);
+    } catch (...) {
+      Dealloc(new_data, new_capacity);
+      throw;
+    }
+    if constexpr (kIsTriviallyRelocatable<T>) {
+      UninitializedRelocate(data_, data_ + position, new_data);
+      UninitializedRelocate(data_ + position, data_ + size_, new_data + position + count);
+    } else {
+      try {
+        std::uninitialized_move(data_, data_ + position, new_data);
+        try {
+          std::uninitialized_move(data_ + position, data_ + size_, new_data + position + count);
+        } catch (...) {
+          std::destroy(new_data, new_data + position);
+          throw;
+        }
+      } catch (...) {
+        std::destroy(new_data + position, new_data + position + count);
+        Dealloc(new_data, new_capacity);
+        throw;
+      }
+      std::destroy(data_, data_ + size_);
     }
+    VectorTrace::OnReallocate<T>(size_ * sizeof(T), capacity_ * sizeof(T), new_capacity * sizeof(T));
+    Dealloc(data_, capacity_);
+    data_ = new_data;
+    size_ += count;
+    capacity_ = new_capacity;
+  }
+
+  template <typename Construct>
+  void ReallocateAndConstruct(SizeType new_capacity, SizeType count, Construct construct) {
+    ReallocateAndInsert(new_capacity, size_, count, construct);
+  }
+
+  // Opens a gap of count elements at position and fills it with construct(gap), reallocating at most once.
+  template <typename Construct>
+  void InsertConstructed(SizeType position, SizeType count, Construct construct) {
+    if (count == 0) {
+      return;
+    }
+    if (size_ + count > capacity_) {
+      SizeType new_capacity = std::max(GrowthPolicy::NextCapacity(capacity_), size_ + count);
+      ReallocateAndInsert(new_capacity, position, count, construct);
+      return;
+    }
+    Pointer gap = data_ + position;
+    SizeType tail = size_ - position;
+    if constexpr (kIsTriviallyRelocatable<T>) {
+      std::memmove(static_cast<void*>(gap + count), static_cast<const void*>(gap), tail * sizeof(T));
+      try {
+        construct(gap);
+      } catch (...) {
+        std::memmove(static_cast<void*>(gap), static_cast<const void*>(gap + count), tail * sizeof(T));
+        throw;
+      }
+      size_ += count;
+    } else {
+      construct(data_ + size_);
+      size_ += count;
+      std::rotate(gap, gap + tail, data_ + size_);
+    }
+  }
+
+  void Reallocate(SizeType new_capacity) {
+    ReallocateAndConstruct(new_capacity, 0, [](Pointer) {});
   }
 };
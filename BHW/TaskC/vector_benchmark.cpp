@@ -0,0 +1,188 @@
+#define VECTOR_PARALLEL_COMPARISON
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <thread>
+#include <vector>
+
+#include "concurrent_vector.h"
+#include "small_vector.h"
+#include "vector.h"
+
+static std::atomic<size_t> heap_allocations = 0;
+static volatile size_t sink = 0;
+
+void* operator new(size_t size) {
+  ++heap_allocations;
+  if (void* p = std::malloc(size == 0 ? 1 : size)) {
+    return p;
+  }
+  throw std::bad_alloc();
+}
+
+// Kept out of line: once inlined, GCC sees free() applied to what operator new returned and warns about the
+// mismatch, although both halves of the pair are replaced here.
+[[gnu::noinline]] void operator delete(void* p) noexcept {
+  std::free(p);
+}
+
+[[gnu::noinline]] void operator delete(void* p, size_t) noexcept {
+  std::free(p);
+}
+
+template <typename F>
+double NanosecondsPerRun(size_t runs, F f) {
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < runs; ++i) {
+    f();
+  }
+  std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+  return elapsed.count() / static_cast<double>(runs);
+}
+
+template <typename Container>
+size_t FillAndSum(size_t size) {
+  Container v;
+  for (size_t i = 0; i < size; ++i) {
+    v.PushBack(i);
+  }
+  size_t sum = 0;
+  for (size_t x : v) {
+    sum += x;
+  }
+  return sum;
+}
+
+template <typename Container>
+void PushBackRow(size_t size) {
+  const size_t runs = 200000;
+  heap_allocations = 0;
+  double ns = NanosecondsPerRun(runs, [size] { sink = FillAndSum<Container>(size); });
+  std::printf(" %10.3f %8.2f", static_cast<double>(heap_allocations) / runs, ns);
+}
+
+void SmallVectorBenchmark() {
+  std::printf("PushBack of n elements: heap allocations and ns per container\n");
+  std::printf("%4s %10s %8s %10s %8s\n", "n", "Vector", "ns", "Small<16>", "ns");
+  for (size_t size = 1; size <= 64; size *= 2) {
+    std::printf("%4zu", size);
+    PushBackRow<Vector<size_t>>(size);
+    PushBackRow<SmallVector<size_t, 16>>(size);
+    std::printf("\n");
+  }
+}
+
+template <typename T>
+void ComparisonRow(size_t bytes) {
+  const size_t n = std::max<size_t>(1, bytes / sizeof(T));
+  const size_t runs = std::max<size_t>(1, (size_t{1} << 28) / bytes);
+  Vector<T> lhs(n, T(1));
+  Vector<T> rhs(n, T(1));
+  rhs.Back() = T(2);
+
+  double baseline_equal = NanosecondsPerRun(runs, [&] { sink = std::equal(lhs.begin(), lhs.end(), rhs.begin()); });
+  double vector_equal = NanosecondsPerRun(runs, [&] { sink = lhs == rhs; });
+  double baseline_less = NanosecondsPerRun(
+      runs, [&] { sink = std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end()); });
+  double vector_less = NanosecondsPerRun(runs, [&] { sink = lhs < rhs; });
+  std::printf(" %9.2f %9.2f %9.2f %9.2f |", bytes / baseline_equal, bytes / vector_equal, bytes / baseline_less,
+              bytes / vector_less);
+}
+
+void ComparisonBenchmark(size_t max_bytes) {
+  std::printf("\nComparison of equal-prefix vectors, GB/s (std::equal, ==, std::lexicographical_compare, <)\n");
+  std::printf("%12s | %39s | %39s | %39s |\n", "bytes", "unsigned char", "int", "double");
+  for (size_t bytes = 16; bytes <= max_bytes; bytes *= 4) {
+    std::printf("%12zu |", bytes);
+    ComparisonRow<unsigned char>(bytes);
+    ComparisonRow<int>(bytes);
+    ComparisonRow<double>(bytes);
+    std::printf("\n");
+  }
+}
+
+template <typename F>
+double RunThreads(size_t threads, F f) {
+  auto start = std::chrono::steady_clock::now();
+  std::vector<std::thread> workers;
+  for (size_t t = 0; t < threads; ++t) {
+    workers.emplace_back(f, t);
+  }
+  for (auto& worker : workers) {
+    worker.join();
+  }
+  std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+  return elapsed.count();
+}
+
+// Every thread appends total / threads elements; the result is then made contiguous. The baseline fills one private
+// Vector per thread and concatenates them.
+void ConcurrentBenchmark(size_t max_threads) {
+  const size_t total = size_t{1} << 24;
+  std::printf("\nAppend of %zu elements from t threads and compaction, ms (ConcurrentVector, private Vectors)\n", total);
+  std::printf("%4s %10s %10s %10s %10s\n", "t", "append", "Freeze", "append", "concat");
+  for (size_t threads = 1; threads <= max_threads; ++threads) {
+    const size_t per_thread = total / threads;
+
+    ConcurrentVector<size_t> shared;
+    double shared_append = RunThreads(threads, [&](size_t t) {
+      for (size_t i = 0; i < per_thread; ++i) {
+        shared.PushBack(t * per_thread + i);
+      }
+    });
+    auto start = std::chrono::steady_clock::now();
+    Vector<size_t> frozen = shared.Freeze();
+    std::chrono::duration<double, std::milli> freeze = std::chrono::steady_clock::now() - start;
+    sink = frozen.Size();
+
+    std::vector<Vector<size_t>> parts(threads);
+    double private_append = RunThreads(threads, [&](size_t t) {
+      for (size_t i = 0; i < per_thread; ++i) {
+        parts[t].PushBack(t * per_thread + i);
+      }
+    });
+    start = std::chrono::steady_clock::now();
+    Vector<size_t> joined;
+    joined.Reserve(per_thread * threads);
+    for (const auto& part : parts) {
+      joined.Append(part.begin(), part.end());
+    }
+    std::chrono::duration<double, std::milli> concat = std::chrono::steady_clock::now() - start;
+    sink = joined.Size();
+
+    std::printf("%4zu %10.2f %10.2f %10.2f %10.2f\n", threads, shared_append, freeze.count(), private_append,
+                concat.count());
+  }
+}
+
+// Build once plain and once with -DVECTOR_TRACE_ALLOCATIONS and compare: disabled tracing must match the plain
+// numbers, since the hooks are empty inline functions then.
+void TraceBenchmark() {
+#ifdef VECTOR_TRACE_ALLOCATIONS
+  const char* mode = "enabled";
+#else
+  const char* mode = "disabled";
+#endif
+  const size_t runs = 200;
+  double ns = NanosecondsPerRun(runs, [] { sink = FillAndSum<Vector<size_t>>(size_t{1} << 16); });
+  std::printf("\nAllocation tracing %s: sizeof(Vector<int>) = %zu, %.3f ns per PushBack\n", mode,
+              sizeof(Vector<int>), ns / (size_t{1} << 16));
+#ifdef VECTOR_TRACE_ALLOCATIONS
+  VectorTrace::DumpJson(std::cout);
+#endif
+}
+
+// Usage: vector_benchmark [max comparison size in MiB, 1024 by default]
+int main(int argc, char** argv) {
+  size_t max_compare_mib = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1024;
+  SmallVectorBenchmark();
+  ComparisonBenchmark(max_compare_mib << 20);
+  TraceBenchmark();
+  ConcurrentBenchmark(std::max(1u, std::thread::hardware_concurrency()));
+  return 0;
+}
@@ -1,6 +1,9 @@
 #define CATCH_CONFIG_MAIN
 #include "catch.hpp"
 
+#include <cstring>
+#include <iterator>
+#include <sstream>
 #include <string>
 #include <string_view>
 #include <vector>
@@ -8,6 +11,7 @@
 
 #include "vector.h"
 #include "vector.h"  // check include guards
+#include "allocators.h"
 
 template <class T>
 void Equal(const Vector<T>& real, const std::vector<T>& required) {
@@ -683,6 +687,231 @@ TEST_CASE("Stress", "[ReallocationStrategy]") {
   }
 }
 
+struct Relocatable {
+  explicit Relocatable(int value = 0) : value(value) {
+  }
+
+  Relocatable(const Relocatable& other) : value(other.value) {
+  }
+
+  Relocatable& operator=(const Relocatable& other) {
+    value = other.value;
+    return *this;
+  }
+
+  int value;
+};
+
+template <>
+struct IsTriviallyRelocatable<Relocatable> : std::true_type {};
+
+TEST_CASE("Relocation", "[ReallocationStrategy]") {
+  REQUIRE(kIsTriviallyRelocatable<int>);
+  REQUIRE_FALSE(kIsTriviallyRelocatable<std::string>);
+  REQUIRE_FALSE(kIsTriviallyRelocatable<std::unique_ptr<int>>);
+  REQUIRE(kIsTriviallyRelocatable<Relocatable>);
+
+  {
+    Vector<Relocatable> v;
+    for (int i = 0; i < 1000; ++i) {
+      v.EmplaceBack(i);
+    }
+    v.Reserve(5000u);
+    v.Resize(500u);
+    v.ShrinkToFit();
+    REQUIRE(v.Capacity() == 500u);
+    for (int i = 0; i < 500; ++i) {
+      REQUIRE(v[i].value == i);
+    }
+  }
+
+  {
+    Vector<std::string> v(4u, std::string(100u, 'a'));
+    REQUIRE(v.Size() == v.Capacity());
+    v.PushBack(v[0]);
+    REQUIRE(v.Size() == 5u);
+    REQUIRE(v[4] == std::string(100u, 'a'));
+    REQUIRE(v[0] == std::string(100u, 'a'));
+  }
+}
+
+TEST_CASE("GrowthPolicy", "[ReallocationStrategy]") {
+  Vector<int, GrowthFactorOneAndHalf> v;
+  size_t reallocations = 0u;
+  for (int i = 0; i < 1000; ++i) {
+    const auto capacity = v.Capacity();
+    v.PushBack(i);
+    if (v.Capacity() != capacity) {
+      ++reallocations;
+      REQUIRE(v.Capacity() <= capacity + capacity / 2 + 1);
+    }
+    REQUIRE(v.Capacity() >= v.Size());
+  }
+  REQUIRE(reallocations > 10u);
+  for (int i = 0; i < 1000; ++i) {
+    REQUIRE(v[i] == i);
+  }
+}
+
+TEST_CASE("Insert", "[DataManipulation]") {
+  {
+    Vector<int> v{1, 2, 6};
+    const std::vector<int> values{3, 4, 5};
+    v.Reserve(10u);
+    const auto pv = v.Data();
+    const auto it = v.Insert(v.begin() + 2, values.begin(), values.end());
+    REQUIRE(it == v.begin() + 2);
+    REQUIRE(pv == v.Data());
+    Equal(v, {1, 2, 3, 4, 5, 6});
+  }
+
+  {
+    Vector<std::string> v{"a", "e"};
+    const std::vector<std::string> values{"b", "c", "d"};
+    v.Insert(v.begin() + 1, values.begin(), values.end());
+    Equal(v, {"a", "b", "c", "d", "e"});
+    v.Insert(v.begin(), values.begin(), values.begin() + 1);
+    v.Insert(v.end(), values.begin(), values.begin());
+    Equal(v, {"b", "a", "b", "c", "d", "e"});
+  }
+
+  {
+    Vector<std::string> v{"a", "b"};
+    v.Reserve(10u);
+    v.Insert(v.begin(), 3u, v[1]);
+    Equal(v, {"b", "b", "b", "a", "b"});
+    v.Insert(v.begin() + 4, 20u, v[3]);
+    REQUIRE(v.Size() == 25u);
+    REQUIRE(v[3] == "a");
+    REQUIRE(v[23] == "a");
+    REQUIRE(v[24] == "b");
+  }
+
+  {
+    Vector<int> v{1, 5};
+    v.Insert(v.begin() + 1, 3u, v[1]);
+    Equal(v, {1, 5, 5, 5, 5});
+  }
+
+  {
+    std::istringstream iss("2 3 4");
+    Vector<int> v{1, 5};
+    v.Insert(v.begin() + 1, std::istream_iterator<int>(iss), std::istream_iterator<int>());
+    Equal(v, {1, 2, 3, 4, 5});
+  }
+}
+
+TEST_CASE("Append", "[DataManipulation]") {
+  const std::vector<int> values(1000u, 7);
+
+  Vector<int> v;
+  v.Append(values.begin(), values.end());
+  REQUIRE(v.Capacity() == 1000u);
+  Equal(v, values);
+
+  v.Append(values.begin(), values.begin() + 10);
+  REQUIRE(v.Size() == 1010u);
+  REQUIRE(v.Capacity() == 2000u);
+
+  Vector<std::unique_ptr<int>> pointers;
+  pointers.PushBack(std::make_unique<int>(0));
+  std::vector<std::unique_ptr<int>> source;
+  for (int i = 1; i < 10; ++i) {
+    source.push_back(std::make_unique<int>(i));
+  }
+  pointers.Append(std::make_move_iterator(source.begin()), std::make_move_iterator(source.end()));
+  for (int i = 0; i < 10; ++i) {
+    REQUIRE(*pointers[i] == i);
+  }
+}
+
+TEST_CASE("Erase", "[DataManipulation]") {
+  {
+    Vector<int> v{1, 2, 3, 4, 5, 6};
+    const auto pv = v.Data();
+    REQUIRE(v.Erase(v.begin() + 1, v.begin() + 3) == v.begin() + 1);
+    Equal(v, {1, 4, 5, 6});
+    REQUIRE(v.Erase(v.begin()) == v.begin());
+    Equal(v, {4, 5, 6});
+    REQUIRE(v.Erase(v.begin(), v.begin()) == v.begin());
+    const auto it = v.Erase(v.begin() + 1, v.end());
+    REQUIRE(it == v.end());
+    Equal(v, {4});
+    REQUIRE(pv == v.Data());
+  }
+
+  {
+    Vector<std::string> v{"a", "b", "c", "d"};
+    v.Erase(v.begin() + 1, v.begin() + 3);
+    Equal(v, {"a", "d"});
+  }
+}
+
+template <typename T>
+struct PatternAllocator {
+  using value_type = T;  // NOLINT
+
+  static constexpr unsigned char kPattern = 0xA5;
+
+  PatternAllocator() = default;
+
+  template <typename U>
+  PatternAllocator(const PatternAllocator<U>&) {  // NOLINT
+  }
+
+  T* allocate(size_t n) {  // NOLINT
+    T* p = std::allocator<T>().allocate(n);
+    std::memset(static_cast<void*>(p), kPattern, n * sizeof(T));
+    return p;
+  }
+
+  void deallocate(T* p, size_t n) {  // NOLINT
+    std::allocator<T>().deallocate(p, n);
+  }
+
+  friend bool operator==(const PatternAllocator&, const PatternAllocator&) {
+    return true;
+  }
+
+  friend bool operator!=(const PatternAllocator&, const PatternAllocator&) {
+    return false;
+  }
+};
+
+TEST_CASE("ResizeDefaultInit", "[ReallocationStrategy]") {
+  constexpr auto kPattern = PatternAllocator<unsigned char>::kPattern;
+
+  {
+    Vector<unsigned char, GrowthFactorTwo, PatternAllocator<unsigned char>> v(3u);
+    v.ResizeUninitialized(1000u);
+    REQUIRE(v.Size() == 1000u);
+    REQUIRE(v.Capacity() == 1000u);
+    for (size_t i = 0; i < 3u; ++i) {
+      REQUIRE(v[i] == 0u);
+    }
+    for (size_t i = 3u; i < 1000u; ++i) {
+      REQUIRE(v[i] == kPattern);
+    }
+  }
+
+  {
+    Vector<unsigned char> v(100u, 7);
+    const auto pv = v.Data();
+    v.ResizeDefaultInit(10u);
+    v.ResizeDefaultInit(100u);
+    REQUIRE(pv == v.Data());
+    for (size_t i = 0; i < 100u; ++i) {
+      REQUIRE(v[i] == 7u);
+    }
+  }
+
+  {
+    Vector<std::string> v(2u, "a");
+    v.ResizeDefaultInit(5u);
+    Equal(v, {"a", "a", "", "", ""});
+  }
+}
+
 template <class T>
 void CheckComparisonEqual(const Vector<T>& lhs, const Vector<T>& rhs) {
   REQUIRE(lhs == rhs);
@@ -769,6 +998,88 @@ TEST_CASE("Comparisons", "[Vector]") {
   }
 }
 
+template <class T>
+void CheckComparisonsAgainstStd(const std::vector<T>& lhs, const std::vector<T>& rhs) {
+  const Vector<T> a(lhs.begin(), lhs.end());
+  const Vector<T> b(rhs.begin(), rhs.end());
+  REQUIRE((a == b) == (lhs == rhs));
+  REQUIRE((a < b) == (lhs < rhs));
+  REQUIRE((b < a) == (rhs < lhs));
+}
+
+TEST_CASE("Bulk Comparisons", "[Vector]") {
+  for (size_t size : {0u, 1u, 15u, 16u, 17u, 31u, 32u, 33u, 100u, 1000u}) {
+    for (size_t diff = 0; diff < size; diff += 1 + diff / 2) {
+      std::vector<int> ints(size, -1);
+      std::vector<int> other_ints = ints;
+      other_ints[diff] = 256;
+      CheckComparisonsAgainstStd(ints, other_ints);
+      other_ints[diff] = -256;
+      CheckComparisonsAgainstStd(ints, other_ints);
+
+      std::vector<unsigned char> bytes(size, 'a');
+      std::vector<unsigned char> other_bytes = bytes;
+      other_bytes[diff] = 'b';
+      CheckComparisonsAgainstStd(bytes, other_bytes);
+
+      std::vector<double> doubles(size, 0.0);
+      std::vector<double> other_doubles = doubles;
+      other_doubles[diff] = -0.0;
+      CheckComparisonsAgainstStd(doubles, other_doubles);
+    }
+    std::vector<int> ints(size, 1);
+    std::vector<int> longer = ints;
+    longer.push_back(0);
+    CheckComparisonsAgainstStd(ints, longer);
+    CheckComparisonsAgainstStd(ints, ints);
+  }
+}
+
+// Padding-free, but its operators only look at key, so it must not be compared as raw bytes.
+struct KeyedValue {
+  int key;
+  int cache;
+
+  friend bool operator==(const KeyedValue& lhs, const KeyedValue& rhs) {
+    return lhs.key == rhs.key;
+  }
+
+  friend bool operator<(const KeyedValue& lhs, const KeyedValue& rhs) {
+    return lhs.key < rhs.key;
+  }
+};
+
+TEST_CASE("User Comparison Operators", "[Vector]") {
+  const Vector<KeyedValue> a{{1, 10}, {2, 20}, {3, 30}};
+  const Vector<KeyedValue> b{{1, -1}, {2, -2}, {3, -3}};
+  const Vector<KeyedValue> c{{1, 100}, {2, -200}, {4, 0}};
+  REQUIRE(a == b);
+  REQUIRE_FALSE(a < b);
+  REQUIRE_FALSE(b < a);
+  REQUIRE(a != c);
+  REQUIRE(a < c);
+  REQUIRE_FALSE(c < a);
+}
+
+// Ordered, but with no operator== at all.
+struct OnlyLess {
+  int value;
+
+  friend bool operator<(const OnlyLess& lhs, const OnlyLess& rhs) {
+    return lhs.value < rhs.value;
+  }
+};
+
+TEST_CASE("Ordering Without Equality", "[Vector]") {
+  const Vector<OnlyLess> a{{1}, {2}, {3}};
+  const Vector<OnlyLess> b{{1}, {3}};
+  REQUIRE(a < b);
+  REQUIRE_FALSE(b < a);
+  REQUIRE(a <= b);
+  REQUIRE(b > a);
+  REQUIRE(b >= a);
+}
+
 TEST_CASE("Iterator", "[Iterators]") {
   {
     using Iterator = Vector<int>::Iterator;
@@ -1425,4 +1736,92 @@ TEST_CASE("PopBack Memory", "[Memory]") {
   REQUIRE(InstanceCounter::counter == 0u);
 }
 
+template <typename T>
+struct CountingAllocator {
+  using value_type = T;  // NOLINT
+
+  static size_t allocations;
+
+  CountingAllocator() = default;
+
+  template <typename U>
+  CountingAllocator(const CountingAllocator<U>&) {  // NOLINT
+  }
+
+  T* allocate(size_t n) {  // NOLINT
+    ++allocations;
+    return std::allocator<T>().allocate(n);
+  }
+
+  void deallocate(T* p, size_t n) {  // NOLINT
+    std::allocator<T>().deallocate(p, n);
+  }
+
+  friend bool operator==(const CountingAllocator&, const CountingAllocator&) {
+    return true;
+  }
+
+  friend bool operator!=(const CountingAllocator&, const CountingAllocator&) {
+    return false;
+  }
+};
+
+template <typename T>
+size_t CountingAllocator<T>::allocations = 0u;
+
+TEST_CASE("Allocator Memory", "[Memory]") {
+  using HeapVector = Vector<InstanceCounter, GrowthFactorTwo, CountingAllocator<InstanceCounter>>;
+  using ArenaVector = Vector<InstanceCounter, GrowthFactorTwo, ArenaAllocator<InstanceCounter>>;
+  InstanceCounter::counter = 0u;
+  CountingAllocator<InstanceCounter>::allocations = 0u;
+
+  SECTION("Heap") {
+    HeapVector v;
+    for (size_t i = 0; i < 100; ++i) {
+      v.PushBack({});
+    }
+    REQUIRE(CountingAllocator<InstanceCounter>::allocations == 8u);
+    REQUIRE(InstanceCounter::counter == 100u);
+  }
+
+  SECTION("Arena") {
+    MonotonicArena arena(1u << 16);
+    {
+      ArenaVector v{ArenaAllocator<InstanceCounter>(arena)};
+      for (size_t i = 0; i < 100; ++i) {
+        v.PushBack({});
+      }
+      REQUIRE(InstanceCounter::counter == 100u);
+
+      ArenaVector copy = v;
+      ArenaVector moved = std::move(v);
+      REQUIRE(copy.GetAllocator() == moved.GetAllocator());
+      REQUIRE(InstanceCounter::counter == 200u);
+    }
+    REQUIRE(arena.Allocations() == 9u);
+    REQUIRE(arena.Chunks() == 1u);
+    REQUIRE(CountingAllocator<InstanceCounter>::allocations == 0u);
+
+    for (size_t i = 0; i < 1000; ++i) {
+      ArenaVector v(10u, ArenaAllocator<InstanceCounter>(arena));
+    }
+    REQUIRE(arena.Allocations() == 1009u);
+    REQUIRE(arena.Chunks() <= 2u);
+    arena.Release();
+  }
+
+  SECTION("Pool") {
+    const InstanceCounter* data = nullptr;
+    {
+      Vector<InstanceCounter, GrowthFactorTwo, PoolAllocator<InstanceCounter>> v(16u);
+      data = v.Data();
+    }
+    Vector<InstanceCounter, GrowthFactorTwo, PoolAllocator<InstanceCounter>> v(16u);
+    REQUIRE(v.Data() == data);
+    REQUIRE(InstanceCounter::counter == 16u);
+  }
+
+  REQUIRE(InstanceCounter::counter == 0u);
+}
+
 #endif
@@ -0,0 +1,144 @@
+#pragma once
+
+#include <cstddef>
+
+#ifdef VECTOR_TRACE_ALLOCATIONS
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <typeinfo>
+
+// Reallocation statistics of Vector, compiled in only with VECTOR_TRACE_ALLOCATIONS. Events are attributed to the
+// innermost VectorTraceScope active on the current thread, or to the element type when there is none.
+class VectorTrace {
+ public:
+  struct Counters {
+    std::atomic<uint64_t> reallocations{0};
+    std::atomic<uint64_t> bytes_moved{0};
+    std::atomic<uint64_t> peak_capacity_bytes{0};
+    std::atomic<uint64_t> wasted_bytes_at_destruction{0};
+  };
+
+  template <typename T>
+  static void OnReallocate(size_t moved_bytes, size_t old_capacity_bytes, size_t new_capacity_bytes) {
+    Counters& counters = Current<T>();
+    counters.reallocations.fetch_add(1, std::memory_order_relaxed);
+    counters.bytes_moved.fetch_add(moved_bytes, std::memory_order_relaxed);
+    UpdatePeak(counters, std::max(old_capacity_bytes, new_capacity_bytes));
+  }
+
+  template <typename T>
+  static void OnDestroy(size_t capacity_bytes, size_t unused_capacity_bytes) {
+    Counters& counters = Current<T>();
+    counters.wasted_bytes_at_destruction.fetch_add(unused_capacity_bytes, std::memory_order_relaxed);
+    UpdatePeak(counters, capacity_bytes);
+  }
+
+  static Counters& Get(const std::string& tag) {
+    std::lock_guard<std::mutex> lock(Mutex());
+    return Registry()[tag];
+  }
+
+  static void Reset() {
+    std::lock_guard<std::mutex> lock(Mutex());
+    for (auto& [tag, counters] : Registry()) {
+      counters.reallocations = 0;
+      counters.bytes_moved = 0;
+      counters.peak_capacity_bytes = 0;
+      counters.wasted_bytes_at_destruction = 0;
+    }
+  }
+
+  static void DumpJson(std::ostream& os) {
+    std::lock_guard<std::mutex> lock(Mutex());
+    os << '{';
+    bool first = true;
+    for (const auto& [tag, counters] : Registry()) {
+      os << (first ? "" : ",") << "\n  \"";
+      for (char c : tag) {
+        if (c == '"' || c == '\\') {
+          os << '\\';
+        }
+        os << c;
+      }
+      os << "\": {\"reallocations\": " << counters.reallocations << ", \"bytes_moved\": " << counters.bytes_moved
+         << ", \"peak_capacity_bytes\": " << counters.peak_capacity_bytes
+         << ", \"wasted_bytes_at_destruction\": " << counters.wasted_bytes_at_destruction << '}';
+      first = false;
+    }
+    os << (first ? "}" : "\n}") << '\n';
+  }
+
+ private:
+  friend class VectorTraceScope;
+
+  static void UpdatePeak(Counters& counters, uint64_t capacity_bytes) {
+    uint64_t peak = counters.peak_capacity_bytes.load(std::memory_order_relaxed);
+    while (peak < capacity_bytes &&
+           !counters.peak_capacity_bytes.compare_exchange_weak(peak, capacity_bytes, std::memory_order_relaxed)) {
+    }
+  }
+
+  static Counters*& ScopeCounters() {
+    thread_local Counters* counters = nullptr;
+    return counters;
+  }
+
+  template <typename T>
+  static Counters& Current() {
+    if (Counters* scope = ScopeCounters()) {
+      return *scope;
+    }
+    static Counters& by_type = Get(typeid(T).name());
+    return by_type;
+  }
+
+  static std::map<std::string, Counters>& Registry() {
+    static std::map<std::string, Counters> registry;
+    return registry;
+  }
+
+  static std::mutex& Mutex() {
+    static std::mutex mutex;
+    return mutex;
+  }
+};
+
+// Attributes all Vector events on this thread to tag while alive, e.g. to tell apart call sites.
+class VectorTraceScope {
+ public:
+  explicit VectorTraceScope(const std::string& tag) : previous_(VectorTrace::ScopeCounters()) {
+    VectorTrace::ScopeCounters() = &VectorTrace::Get(tag);
+  }
+
+  VectorTraceScope(const VectorTraceScope&) = delete;
+  VectorTraceScope& operator=(const VectorTraceScope&) = delete;
+
+  ~VectorTraceScope() {
+    VectorTrace::ScopeCounters() = previous_;
+  }
+
+ private:
+  VectorTrace::Counters* previous_;
+};
+
+#else
+
+// Without VECTOR_TRACE_ALLOCATIONS the hooks are empty inline functions and compile to nothing.
+class VectorTrace {
+ public:
+  template <typename T>
+  static void OnReallocate(size_t, size_t, size_t) {
+  }
+
+  template <typename T>
+  static void OnDestroy(size_t, size_t) {
+  }
+};
+
+#endif  // VECTOR_TRACE_ALLOCATIONS
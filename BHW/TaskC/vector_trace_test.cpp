@@ -0,0 +1,54 @@
+#define CATCH_CONFIG_MAIN
+#define VECTOR_TRACE_ALLOCATIONS
+#include "catch.hpp"
+
+#include <sstream>
+#include <string>
+#include <typeinfo>
+
+#include "vector.h"
+#include "vector_trace.h"  // check include guards
+
+TEST_CASE("No Extra State", "[VectorTrace]") {
+  REQUIRE(sizeof(Vector<int>) == 3 * sizeof(int*));
+}
+
+TEST_CASE("Type Counters", "[VectorTrace]") {
+  VectorTrace::Reset();
+  {
+    Vector<long double> v;
+    for (int i = 0; i < 100; ++i) {
+      v.PushBack(i);
+    }
+  }
+  const auto& counters = VectorTrace::Get(typeid(long double).name());
+  REQUIRE(counters.reallocations == 8u);
+  REQUIRE(counters.bytes_moved == (1u + 2u + 4u + 8u + 16u + 32u + 64u) * sizeof(long double));
+  REQUIRE(counters.peak_capacity_bytes == 128u * sizeof(long double));
+  REQUIRE(counters.wasted_bytes_at_destruction == 28u * sizeof(long double));
+}
+
+TEST_CASE("Scoped Counters", "[VectorTrace]") {
+  VectorTrace::Reset();
+  {
+    VectorTraceScope outer("outer");
+    Vector<int> a(10u);
+    {
+      VectorTraceScope inner("inner \"site\"");
+      Vector<int> b;
+      b.Reserve(50u);
+      b.PushBack(1);
+    }
+    a.PushBack(1);
+  }
+  REQUIRE(VectorTrace::Get("outer").reallocations == 1u);
+  REQUIRE(VectorTrace::Get("outer").bytes_moved == 10u * sizeof(int));
+  REQUIRE(VectorTrace::Get("outer").peak_capacity_bytes == 20u * sizeof(int));
+  REQUIRE(VectorTrace::Get("outer").wasted_bytes_at_destruction == 9u * sizeof(int));
+  REQUIRE(VectorTrace::Get("inner \"site\"").wasted_bytes_at_destruction == 49u * sizeof(int));
+
+  std::ostringstream oss;
+  VectorTrace::DumpJson(oss);
+  REQUIRE(oss.str().find(R"("inner \"site\"": {"reallocations": 1, "bytes_moved": 0, "peak_capacity_bytes": 200, )"
+                         R"("wasted_bytes_at_destruction": 196})") != std::string::npos);
+}
@@ -3,28 +3,14 @@
 BigInteger::BigInteger() : is_negative_(false) {
 }
 
-BigInteger::BigInteger(int value) : is_negative_(value < 0) {
-  if (value != 0){
-    if (value < 0) {
-      value = -value;
-    }
-    while (value > 0) {
-      digits_.push_back(value % kBASE);
-      value /= kBASE;
-    }
-  }
+BigInteger::BigInteger(int value) : BigInteger(static_cast<int64_t>(value)) {
 }
 
 BigInteger::BigInteger(int64_t value) : is_negative_(value < 0) {
-  if (value != 0) {
-    if (value < 0) {
-      value = -value;
-    }
-    while (value > 0) {
-      int digit = static_cast<int>(value % kBASE);
-      digits_.push_back(digit);
-      value /= kBASE;
-    }
+  uint64_t magnitude = value < 0 ? 0 - static_cast<uint64_t>(value) : static_cast<uint64_t>(value);
+  while (magnitude > 0) {
+    limbs_.PushBack(static_cast<Limb>(magnitude));
+    magnitude >>= kLimbBits;
   }
 }
 
@@ -36,8 +22,12 @@ BigInteger::BigInteger(const std::string& value) {
   FromString(value);
 }
 
+BigInteger::BigInteger(BigIntegerView value)
+    : limbs_(value.limbs_, value.limbs_ + value.size_), is_negative_(value.is_negative_) {
+}
+
 BigInteger::BigInteger(BigInteger&& other) noexcept
-    : digits_(std::move(other.digits_)), is_negative_(other.is_negative_) {
+    : limbs_(std::move(other.limbs_)), is_negative_(other.is_negative_) {
   other.is_negative_ = false;
 }
 
@@ -58,102 +48,79 @@ BigInteger BigInteger::operator+() const {
 BigInteger BigInteger::operator-() const {
   BigInteger result = *this;
   result.is_negative_ = !is_negative_;
+  result.Trim();
   return result;
 }
 
 BigInteger& BigInteger::operator+=(const BigInteger& other) {
-  if (is_negative_ == other.is_negative_) {
-    int carry = 0;
-    for (size_t i = 0; i < std::max(digits_.size(), other.digits_.size()) || carry; ++i) {
-      if (i == digits_.size()) {
-        digits_.push_back(0);
-      }
-      if (i < other.digits_.size()) {
-        digits_[i] += carry + other.digits_[i];
-      } else {
-        digits_[i] += carry;
-      }
-      carry = digits_[i] >= kBASE;
-      if (carry) {
-        digits_[i] -= kBASE;
-      }
-      if (digits_[i] < 0 || digits_[i] >= kBASE) {
-        throw BigIntegerOverflow();
-      }
-    }
-  } else {
-    *this -= -other;
-  }
-  Trim();
-  return *this;
+  return AddSigned(other.limbs_.Data(), other.limbs_.Size(), other.is_negative_);
 }
 
 BigInteger& BigInteger::operator-=(const BigInteger& other) {
-  if (is_negative_ == other.is_negative_) {
-    if (Abs() >= other.Abs()) {
-      int carry = 0;
-      for (size_t i = 0; i < other.digits_.size() || carry; ++i) {
-        if (i == digits_.size()) {
-          digits_.push_back(0);
-        }
-        if (i < other.digits_.size()) {
-          digits_[i] -= carry + other.digits_[i];
-        } else {
-          digits_[i] -= carry;
-        }
-        carry = digits_[i] < 0;
-        if (carry) {
-          digits_[i] += kBASE;
-        }
-        if (digits_[i] < 0 || digits_[i] >= kBASE) {
-          throw BigIntegerOverflow();
-        }
-      }
-      Trim();
-    } else {
-      *this = -(other - *this);
-    }
-  } else {
-    *this += -other;
-  }
-  return *this;
+  return AddSigned(other.limbs_.Data(), other.limbs_.Size(), !other.is_negative_);
 }
 
-BigInteger& BigInteger::operator*=(const BigInteger& other) {
-  std::vector<uint64_t> result(digits_.size() + other.digits_.size(), 0);
-  for (size_t i = 0; i < digits_.size(); ++i) {
-    for (size_t j = 0; j < other.digits_.size(); ++j) {
-      uint64_t product = static_cast<uint64_t>(digits_[i]) * other.digits_[j];
-      if (product >= static_cast<uint64_t>(std::numeric_limits<int64_t>::max())) {
-        throw BigIntegerOverflow();
-      }
-      result[i + j] += product;
-      if (result[i + j] >= kBASE) {
-        result[i + j + 1] += result[i + j] / kBASE;
-        result[i + j] %= kBASE;
-      }
-    }
-  }
+BigInteger& BigInteger::operator+=(int64_t other) {
+  Limb parts[2];
+  return AddSigned(parts, SplitMagnitude(other, parts), other < 0);
+}
 
-  digits_ = std::vector<int>(result.begin(), result.end());
+BigInteger& BigInteger::operator-=(int64_t other) {
+  Limb parts[2];
+  return AddSigned(parts, SplitMagnitude(other, parts), other >= 0);
+}
+
+BigInteger& BigInteger::operator*=(const BigInteger& other) {
+  limbs_ = &other == this ? SqrAbs(limbs_) : MulAbs(limbs_, other.limbs_);
   is_negative_ = is_negative_ != other.is_negative_;
+  Trim();
 
-  for (size_t i = 0; i < digits_.size(); ++i) {
-    if (digits_[i] < 0 || digits_[i] >= kBASE) {
-      throw BigIntegerOverflow();
-    }
+  if (ExceedsDigitLimit()) {
+    throw BigIntegerOverflow();
   }
+  return *this;
+}
 
+BigInteger& BigInteger::operator*=(int64_t other) {
+  Limb parts[2];
+  if (SplitMagnitude(other, parts) == 2) {
+    return *this *= BigInteger(other);
+  }
+  MulAddLimb(limbs_, parts[0], 0);
+  is_negative_ = is_negative_ != (other < 0);
   Trim();
 
-  if (DigitCount() > 30009) {
+  if (ExceedsDigitLimit()) {
     throw BigIntegerOverflow();
   }
   return *this;
 }
 
+BigInteger& BigInteger::operator+=(BigIntegerView other) {
+  return AddSigned(other.limbs_, other.size_, other.is_negative_);
+}
+
+BigInteger& BigInteger::operator-=(BigIntegerView other) {
+  return AddSigned(other.limbs_, other.size_, !other.is_negative_);
+}
+
+BigInteger& BigInteger::AddMul(const BigInteger& lhs, const BigInteger& rhs) {
+  return AddMulSigned(lhs, rhs, lhs.is_negative_ != rhs.is_negative_);
+}
+
+BigInteger& BigInteger::SubMul(const BigInteger& lhs, const BigInteger& rhs) {
+  return AddMulSigned(lhs, rhs, lhs.is_negative_ == rhs.is_negative_);
+}
 
+BigInteger& BigInteger::operator/=(const BigInteger& other) {
+  *this = DivMod(*this, other).first;
+  return *this;
+}
 
+BigInteger& BigInteger::operator%=(const BigInteger& other) {
+  *this = DivMod(*this, other).second;
+  return *this;
+}
 
 BigInteger& BigInteger::operator=(int value) {
   *this = BigInteger(value);
@@ -162,7 +129,7 @@ BigInteger& BigInteger::operator=(int value) {
 
 BigInteger& BigInteger::operator=(const BigInteger& other) {
   if (this != &other) {
-    digits_ = other.digits_;
+    limbs_ = other.limbs_;
     is_negative_ = other.is_negative_;
   }
   return *this;
@@ -170,7 +137,7 @@ BigInteger& BigInteger::operator=(const BigInteger& other) {
 
 BigInteger& BigInteger::operator=(BigInteger&& other) noexcept {
   if (this != &other) {
-    digits_ = std::move(other.digits_);
+    limbs_ = std::move(other.limbs_);
     is_negative_ = other.is_negative_;
     other.is_negative_ = false;
   }
@@ -189,38 +156,280 @@ BigInteger operator*(BigInteger lhs, const BigInteger& rhs) {
   return lhs *= rhs;
 }
 
+BigInteger operator+(BigInteger lhs, int64_t rhs) {
+  return lhs += rhs;
+}
+
+BigInteger operator-(BigInteger lhs, int64_t rhs) {
+  return lhs -= rhs;
+}
+
+BigInteger operator*(BigInteger lhs, int64_t rhs) {
+  return lhs *= rhs;
+}
+
+BigInteger operator/(BigInteger lhs, const BigInteger& rhs) {
+  return lhs /= rhs;
+}
+
+BigInteger operator%(BigInteger lhs, const BigInteger& rhs) {
+  return lhs %= rhs;
+}
+
+std::pair<BigInteger, BigInteger> DivMod(const BigInteger& lhs, const BigInteger& rhs) {
+  if (!rhs) {
+    throw BigIntegerDivisionByZero();
+  }
+  std::pair<BigInteger, BigInteger> result;
+  BigInteger::DivModAbs(lhs.limbs_, rhs.limbs_, result.first.limbs_, result.second.limbs_);
+  result.first.is_negative_ = lhs.is_negative_ != rhs.is_negative_;
+  result.first.Trim();
+  result.second.is_negative_ = lhs.is_negative_;
+  result.second.Trim();
+  return result;
+}
 
 BigInteger& BigInteger::operator++() {
-  *this += BigInteger(1);
-  return *this;
+  return *this += 1;
 }
 
 BigInteger BigInteger::operator++(int) {
   BigInteger temp(*this);
-  *this += BigInteger(1);
+  *this += 1;
   return temp;
 }
 
 BigInteger& BigInteger::operator--() {
-  *this -= BigInteger(1);
-  return *this;
+  return *this -= 1;
 }
 
 BigInteger BigInteger::operator--(int) {
   BigInteger temp(*this);
-  *this -= BigInteger(1);
+  *this -= 1;
   return temp;
 }
 
 BigInteger::operator bool() const {
-  return !digits_.empty();
+  return !limbs_.Empty();
 }
 
-bool operator==(const BigInteger& lhs, const BigInteger& rhs) {
-  if (lhs.digits_.empty() && rhs.digits_.empty()) {
+namespace {
+
+// Bits in a nonzero limb and set bits in a limb, by the compiler intrinsics where there are some.
+int LimbBitLength(uint32_t limb) {
+#if defined(__GNUC__) || defined(__clang__)
+  return 32 - __builtin_clz(limb);
+#else
+  int bits = 0;
+  for (; limb > 0; limb >>= 1) {
+    ++bits;
+  }
+  return bits;
+#endif
+}
+
+int LimbPopCount(uint32_t limb) {
+#if defined(__GNUC__) || defined(__clang__)
+  return __builtin_popcount(limb);
+#else
+  int count = 0;
+  for (; limb > 0; limb &= limb - 1) {
+    ++count;
+  }
+  return count;
+#endif
+}
+
+}  // namespace
+
+size_t BigInteger::BitLength() const {
+  if (limbs_.Empty()) {
+    return 0;
+  }
+  return (limbs_.Size() - 1) * kLimbBits + LimbBitLength(limbs_.Back());
+}
+
+size_t BigInteger::PopCount() const {
+  size_t count = 0;
+  for (Limb limb : limbs_) {
+    count += LimbPopCount(limb);
+  }
+  return count;
+}
+
+// The two's complement of -m is ~(m - 1): below the lowest nonzero limb of m it is zero, at that limb it is -limb and
+// above it the complement of m.
+bool BigInteger::TestBit(size_t index) const {
+  const size_t position = index / kLimbBits;
+  const int bit = index % kLimbBits;
+  if (!is_negative_) {
+    return position < limbs_.Size() && (limbs_[position] >> bit) & 1;
+  }
+  if (position >= limbs_.Size()) {
     return true;
   }
-  return lhs.is_negative_ == rhs.is_negative_ && lhs.digits_ == rhs.digits_;
+  size_t lowest = 0;
+  while (limbs_[lowest] == 0) {
+    ++lowest;
+  }
+  Limb word = position < lowest ? 0 : position == lowest ? 0 - limbs_[position] : ~limbs_[position];
+  return (word >> bit) & 1;
+}
+
+// Applies operation limb by limb to the two's complements of *this and other, produced on the fly as ~(m - 1) for a
+// negative magnitude m, one limb longer than the longer operand so that the sign limbs are included. The result is
+// negative when operation gives ones for the two sign fillers, and its magnitude is then recovered as ~r + 1. other
+// may be *this.
+template <class Operation>
+BigInteger& BigInteger::BitwiseAssign(const BigInteger& other, Operation operation) {
+  const bool lhs_negative = is_negative_;
+  const bool rhs_negative = other.is_negative_;
+  const bool negative = operation(lhs_negative ? ~Limb{0} : 0, rhs_negative ? ~Limb{0} : 0) != 0;
+  const size_t rhs_size = other.limbs_.Size();
+  auto twos_complement = [](Limb magnitude, bool is_negative, Limb& borrow) {
+    if (!is_negative) {
+      return magnitude;
+    }
+    Limb difference = magnitude - borrow;
+    borrow = magnitude < borrow;
+    return static_cast<Limb>(~difference);
+  };
+
+  limbs_.Resize(std::max(limbs_.Size(), rhs_size) + 1, 0);
+  Limb lhs_borrow = 1;
+  Limb rhs_borrow = 1;
+  Limb carry = 1;
+  for (size_t i = 0; i < limbs_.Size(); ++i) {
+    Limb lhs = twos_complement(limbs_[i], lhs_negative, lhs_borrow);
+    Limb rhs = twos_complement(i < rhs_size ? other.limbs_[i] : 0, rhs_negative, rhs_borrow);
+    Limb result = operation(lhs, rhs);
+    if (negative) {
+      result = ~result + carry;
+      carry = result < carry;
+    }
+    limbs_[i] = result;
+  }
+  is_negative_ = negative;
+  Trim();
+  return *this;
+}
+
+BigInteger BigInteger::operator~() const {
+  BigInteger result = -*this;
+  return result -= 1;
+}
+
+BigInteger& BigInteger::operator&=(const BigInteger& other) {
+  return BitwiseAssign(other, [](Limb lhs, Limb rhs) { return lhs & rhs; });
+}
+
+BigInteger& BigInteger::operator|=(const BigInteger& other) {
+  return BitwiseAssign(other, [](Limb lhs, Limb rhs) { return lhs | rhs; });
+}
+
+BigInteger& BigInteger::operator^=(const BigInteger& other) {
+  return BitwiseAssign(other, [](Limb lhs, Limb rhs) { return lhs ^ rhs; });
+}
+
+// Whole limbs move with one copy and the remaining bits with one pass of ShiftLeftBits. A shift by more than four bits
+// per allowed digit overflows whatever the value, and is refused before any memory is touched.
+BigInteger& BigInteger::operator<<=(size_t shift) {
+  if (limbs_.Empty()) {
+    return *this;
+  }
+  if (max_digits_ != std::numeric_limits<size_t>::max() && shift / 4 > max_digits_) {
+    throw BigIntegerOverflow();
+  }
+  const size_t limb_shift = shift / kLimbBits;
+  if (limb_shift > 0) {
+    const size_t size = limbs_.Size();
+    limbs_.Resize(size + limb_shift, 0);
+    std::copy_backward(limbs_.begin(), limbs_.begin() + size, limbs_.end());
+    std::fill(limbs_.begin(), limbs_.begin() + limb_shift, 0);
+  }
+  ShiftLeftBits(limbs_, static_cast<int>(shift % kLimbBits));
+
+  if (ExceedsDigitLimit()) {
+    throw BigIntegerOverflow();
+  }
+  return *this;
+}
+
+// floor(x / 2^shift): a negative value whose shifted-out bits are not all zero moves one further from zero.
+BigInteger& BigInteger::operator>>=(size_t shift) {
+  const size_t limb_shift = shift / kLimbBits;
+  const int bit_shift = static_cast<int>(shift % kLimbBits);
+  if (limb_shift >= limbs_.Size()) {
+    *this = is_negative_ ? -1 : 0;
+    return *this;
+  }
+  bool inexact = false;
+  if (is_negative_) {
+    for (size_t i = 0; i < limb_shift && !inexact; ++i) {
+      inexact = limbs_[i] != 0;
+    }
+    inexact = inexact || (limbs_[limb_shift] & ((Limb{1} << bit_shift) - 1)) != 0;
+  }
+  if (limb_shift > 0) {
+    std::copy(limbs_.begin() + limb_shift, limbs_.end(), limbs_.begin());
+    limbs_.Resize(limbs_.Size() - limb_shift);
+  }
+  ShiftRightBits(limbs_, bit_shift);
+  if (inexact) {
+    const Limb one = 1;
+    AddAbsShifted(limbs_, &one, 1, 0);
+  }
+  Trim();
+  return *this;
+}
+
+BigInteger operator&(BigInteger lhs, const BigInteger& rhs) {
+  return lhs &= rhs;
+}
+
+BigInteger operator|(BigInteger lhs, const BigInteger& rhs) {
+  return lhs |= rhs;
+}
+
+BigInteger operator^(BigInteger lhs, const BigInteger& rhs) {
+  return lhs ^= rhs;
+}
+
+BigInteger operator<<(BigInteger lhs, size_t shift) {
+  return lhs <<= shift;
+}
+
+BigInteger operator>>(BigInteger lhs, size_t shift) {
+  return lhs >>= shift;
+}
+
+size_t BigInteger::MaxCharsLength() const {
+  return static_cast<size_t>(static_cast<double>(BitLength()) * std::log10(2.0)) + 2;
+}
+
+char* BigInteger::ToChars(char* first) const {
+  if (limbs_.Empty()) {
+    *first = '0';
+    return first + 1;
+  }
+  if (is_negative_) {
+    *first++ = '-';
+  }
+  size_t level = 0;
+  while (CompareAbs(DecimalPower(level), limbs_) <= 0) {
+    ++level;
+  }
+  return WriteDecimal(limbs_, level, false, first);
+}
+
+std::string BigInteger::ToString() const {
+  std::string text(MaxCharsLength(), '\0');
+  text.resize(ToChars(text.data()) - text.data());
+  return text;
+}
+
+bool operator==(const BigInteger& lhs, const BigInteger& rhs) {
+  return lhs.is_negative_ == rhs.is_negative_ && lhs.limbs_ == rhs.limbs_;
 }
 
 bool operator!=(const BigInteger& lhs, const BigInteger& rhs) {
@@ -231,15 +440,8 @@ bool operator<(const BigInteger& lhs, const BigInteger& rhs) {
   if (lhs.is_negative_ != rhs.is_negative_) {
     return lhs.is_negative_;
   }
-  if (lhs.digits_.size() != rhs.digits_.size()) {
-    return lhs.digits_.size() * (lhs.is_negative_ ? -1 : 1) < rhs.digits_.size() * (rhs.is_negative_ ? -1 : 1);
-  }
-  for (int i = static_cast<int>(lhs.digits_.size()) - 1; i >= 0; --i) {
-    if (lhs.digits_[i] != rhs.digits_[i]) {
-      return lhs.digits_[i] * (lhs.is_negative_ ? -1 : 1) < rhs.digits_[i] * (rhs.is_negative_ ? -1 : 1);
-    }
-  }
-  return false;
+  int order = BigInteger::CompareAbs(lhs.limbs_, rhs.limbs_);
+  return lhs.is_negative_ ? order > 0 : order < 0;
 }
 
 bool operator<=(const BigInteger& lhs, const BigInteger& rhs) {
@@ -255,14 +457,7 @@ bool operator>=(const BigInteger& lhs, const BigInteger& rhs) {
 }
 
 std::ostream& operator<<(std::ostream& os, const BigInteger& value) {
-  if (value.is_negative_) {
-    os << '-';
-  }
-  os << (value.digits_.empty() ? 0 : value.digits_.back());
-  for (int i = static_cast<int>(value.digits_.size()) - 2; i >= 0; --i) {
-    os << std::setw(BigInteger::kBaseDigits) << std::setfill('0') << value.digits_[i];
-  }
-  return os;
+  return os << value.ToString();
 }
 
 std::istream& operator>>(std::istream& is, BigInteger& value) {
@@ -272,11 +467,75 @@ std::istream& operator>>(std::istream& is, BigInteger& value) {
   return is;
 }
 
+namespace {
+
+uint32_t LoadLittleEndian(const std::byte* bytes) {
+  return std::to_integer<uint32_t>(bytes[0]) | std::to_integer<uint32_t>(bytes[1]) << 8 |
+         std::to_integer<uint32_t>(bytes[2]) << 16 | std::to_integer<uint32_t>(bytes[3]) << 24;
+}
+
+void StoreLittleEndian(uint32_t value, std::byte* bytes) {
+  for (int i = 0; i < 4; ++i) {
+    bytes[i] = static_cast<std::byte>(value >> (8 * i));
+  }
+}
+
+}  // namespace
+
+size_t BigInteger::SerializedSize() const {
+  return kSerializedHeaderBytes + limbs_.Size() * sizeof(Limb);
+}
+
+std::byte* BigInteger::Serialize(std::byte* first) const {
+  if (limbs_.Size() > std::numeric_limits<uint32_t>::max() / 2) {
+    throw BigIntegerFormatError("BigInteger too long to serialize");
+  }
+  StoreLittleEndian(static_cast<uint32_t>(limbs_.Size() * 2 + is_negative_), first);
+  first += kSerializedHeaderBytes;
+  for (Limb limb : limbs_) {
+    StoreLittleEndian(limb, first);
+    first += sizeof(Limb);
+  }
+  return first;
+}
+
+const std::byte* BigInteger::Deserialize(const std::byte* first, const std::byte* last, BigInteger& value) {
+  size_t size;
+  bool negative;
+  first = ReadSerializedHeader(first, last, size, negative);
+  value.limbs_.Resize(size, 0);
+  for (Limb& limb : value.limbs_) {
+    limb = LoadLittleEndian(first);
+    first += sizeof(Limb);
+  }
+  value.is_negative_ = negative;
+  return first;
+}
+
+// Checks the record at first and returns the start of its limbs.
+const std::byte* BigInteger::ReadSerializedHeader(const std::byte* first, const std::byte* last, size_t& size,
+                                                  bool& negative) {
+  if (static_cast<size_t>(last - first) < kSerializedHeaderBytes) {
+    throw BigIntegerFormatError("Truncated BigInteger header");
+  }
+  uint32_t header = LoadLittleEndian(first);
+  first += kSerializedHeaderBytes;
+  size = header >> 1;
+  negative = header & 1;
+  if (static_cast<size_t>(last - first) / sizeof(Limb) < size) {
+    throw BigIntegerFormatError("Truncated BigInteger limbs");
+  }
+  if (size == 0 ? negative : LoadLittleEndian(first + (size - 1) * sizeof(Limb)) == 0) {
+    throw BigIntegerFormatError("Non-canonical BigInteger record");
+  }
+  return first;
+}
+
 void BigInteger::Trim() {
-  while (!digits_.empty() && digits_.back() == 0) {
-    digits_.pop_back();
+  while (!limbs_.Empty() && limbs_.Back() == 0) {
+    limbs_.PopBack();
   }
-  if (digits_.empty()) {
+  if (limbs_.Empty()) {
     is_negative_ = false;
   }
 }
@@ -284,41 +543,1608 @@ void BigInteger::Trim() {
 
 
 void BigInteger::FromString(const std::string& value) {
-  is_negative_ = false;
-  digits_.clear();
-  int pos = 0;
-  if (value[0] == '-') {
-    is_negative_ = true;
-    pos = 1;
-  } else if (value[0] == '+') {
+  size_t pos = 0;
+  if (!value.empty() && (value[0] == '-' || value[0] == '+')) {
     pos = 1;
   }
-  for (int i = static_cast<int>(value.size()) - 1; i >= pos; i -= kBaseDigits) {
-    int x = 0;
-    for (int j = std::max(pos, i - kBaseDigits + 1); j <= i; ++j) {
-      if (x > (std::numeric_limits<int>::max() - (value[j] - '0')) / 10) {
-        throw BigIntegerOverflow();
-      }
-      x = x * 10 + (value[j] - '0');
-    }
-    if (x < 0 || x >= kBASE) {
-      throw BigIntegerOverflow();
+  limbs_ = ParseDecimal(value.data() + pos, value.size() - pos);
+  is_negative_ = !value.empty() && value[0] == '-';
+  Trim();
+}
+
+// The result may have at most max_digits_ decimal digits, i.e. must stay below 10^max_digits_. 10^d has
+// floor(d log2 10) + 1 bits, so the bit length settles almost every case; one bit of slack absorbs rounding in that
+// estimate. The power of ten is built, and kept until the limit changes, only for values of about the same length;
+// threads share it under a mutex, as they share DecimalPower.
+bool BigInteger::ExceedsDigitLimit() const {
+  if (max_digits_ == std::numeric_limits<size_t>::max()) {
+    return false;
+  }
+  size_t limit_bits = static_cast<size_t>(static_cast<double>(max_digits_) * std::log2(10.0)) + 1;
+  size_t bits = BitLength();
+  if (bits + 1 < limit_bits) {
+    return false;
+  }
+  if (bits > limit_bits + 1) {
+    return true;
+  }
+  static std::mutex mutex;
+  static Limbs limit;
+  static size_t limit_digits = 0;
+  std::lock_guard<std::mutex> lock(mutex);
+  if (limit.Empty() || limit_digits != max_digits_) {
+    limit = PowerOfTen(max_digits_);
+    limit_digits = max_digits_;
+  }
+  return CompareAbs(limbs_, limit) >= 0;
+}
+
+// *this += other, given as a magnitude span and a sign, so that subtraction needs no negated copy and small integers
+// no BigInteger. other may point into limbs_.
+BigInteger& BigInteger::AddSigned(const Limb* other, size_t other_size, bool other_negative) {
+  if (other_size == 0) {
+    return *this;
+  }
+  if (is_negative_ == other_negative) {
+    AddAbsShifted(limbs_, other, other_size, 0);
+  } else if (CompareAbs(limbs_.Data(), limbs_.Size(), other, other_size) >= 0) {
+    SubAbs(limbs_, other, other_size);
+  } else {
+    SubAbsFrom(limbs_, other, other_size);
+    is_negative_ = other_negative;
+  }
+  Trim();
+  return *this;
+}
+
+// *this += lhs * rhs when negative is false and *this -= |lhs * rhs| otherwise. When the product adds to the
+// magnitude and the shorter factor is below the Karatsuba threshold, its rows are accumulated straight into limbs_.
+BigInteger& BigInteger::AddMulSigned(const BigInteger& lhs, const BigInteger& rhs, bool negative) {
+  const Limbs& longer = lhs.limbs_.Size() >= rhs.limbs_.Size() ? lhs.limbs_ : rhs.limbs_;
+  const Limbs& shorter = lhs.limbs_.Size() >= rhs.limbs_.Size() ? rhs.limbs_ : lhs.limbs_;
+  if (shorter.Empty()) {
+    return *this;
+  }
+  if ((limbs_.Empty() || is_negative_ == negative) && shorter.Size() < multiplication_thresholds_.karatsuba &&
+      &lhs != this && &rhs != this) {
+    is_negative_ = negative;
+    for (size_t i = 0; i < shorter.Size(); ++i) {
+      AddMulLimb(limbs_, longer, shorter[i], i);
     }
-    digits_.push_back(x);
+  } else {
+    Limbs product = MulAbs(longer, shorter);
+    AddSigned(product.Data(), product.Size(), negative);
   }
   Trim();
+
+  if (ExceedsDigitLimit()) {
+    throw BigIntegerOverflow();
+  }
+  return *this;
 }
 
+// Limbs of |value| in parts; returns how many of them are significant.
+size_t BigInteger::SplitMagnitude(int64_t value, Limb parts[2]) {
+  uint64_t magnitude = value < 0 ? 0 - static_cast<uint64_t>(value) : static_cast<uint64_t>(value);
+  parts[0] = static_cast<Limb>(magnitude);
+  parts[1] = static_cast<Limb>(magnitude >> kLimbBits);
+  return parts[1] > 0 ? 2 : parts[0] > 0 ? 1 : 0;
+}
 
-size_t BigInteger::DigitCount() const{
-  if (digits_.empty() || (digits_.size() == 1 && digits_[0] == 0)) {
-    return 1;
+// limbs = limbs * multiplier + addend.
+void BigInteger::MulAddLimb(Limbs& limbs, Limb multiplier, Limb addend) {
+  DoubleLimb carry = addend;
+  for (Limb& limb : limbs) {
+    carry += static_cast<DoubleLimb>(limb) * multiplier;
+    limb = static_cast<Limb>(carry);
+    carry >>= kLimbBits;
+  }
+  if (carry > 0) {
+    limbs.PushBack(static_cast<Limb>(carry));
+  }
+}
+
+// Divides the magnitude by divisor in place and returns the remainder.
+BigInteger::Limb BigInteger::DivModSmall(Limb divisor) {
+  Limb remainder = DivModLimb(limbs_, divisor);
+  Trim();
+  return remainder;
+}
+
+void BigInteger::TrimLimbs(Limbs& limbs) {
+  while (!limbs.Empty() && limbs.Back() == 0) {
+    limbs.PopBack();
+  }
+}
+
+// Limbs [begin, end) of limbs, clamped to its size and trimmed.
+BigInteger::Limbs BigInteger::Slice(const Limbs& limbs, size_t begin, size_t end) {
+  end = std::min(end, limbs.Size());
+  if (begin >= end) {
+    return {};
+  }
+  Limbs slice(limbs.begin() + begin, limbs.begin() + end);
+  TrimLimbs(slice);
+  return slice;
+}
+
+// The magnitude kernels take trimmed limb spans, so that callers can pass a limb array on the stack.
+int BigInteger::CompareAbs(const Limb* lhs, size_t lhs_size, const Limb* rhs, size_t rhs_size) {
+  if (lhs_size != rhs_size) {
+    return lhs_size < rhs_size ? -1 : 1;
+  }
+  for (size_t i = lhs_size; i-- > 0;) {
+    if (lhs[i] != rhs[i]) {
+      return lhs[i] < rhs[i] ? -1 : 1;
+    }
+  }
+  return 0;
+}
+
+int BigInteger::CompareAbs(const Limbs& lhs, const Limbs& rhs) {
+  return CompareAbs(lhs.Data(), lhs.Size(), rhs.Data(), rhs.Size());
+}
+
+// lhs += rhs. lhs and rhs may be the same vector.
+void BigInteger::AddAbs(Limbs& lhs, const Limbs& rhs) {
+  AddAbsShifted(lhs, rhs.Data(), rhs.Size(), 0);
+}
+
+void BigInteger::AddAbsShifted(Limbs& lhs, const Limbs& rhs, size_t shift) {
+  AddAbsShifted(lhs, rhs.Data(), rhs.Size(), shift);
+}
+
+// lhs += rhs * 2^(32 * shift). rhs may point into lhs only if shift is 0: lhs is then not resized before the last
+// read of rhs.
+void BigInteger::AddAbsShifted(Limbs& lhs, const Limb* rhs, size_t rhs_size, size_t shift) {
+  if (rhs_size == 0) {
+    return;
+  }
+  if (lhs.Size() < shift + rhs_size) {
+    lhs.Resize(shift + rhs_size, 0);
   }
-  size_t digit_count = (digits_.size() - 1) * kBaseDigits;
-  int last_digit = digits_.back();
-  while (last_digit > 0) {
-    last_digit /= 10;
-    digit_count++;
+  DoubleLimb carry = 0;
+  size_t i = shift;
+  for (size_t j = 0; j < rhs_size; ++i, ++j) {
+    carry += static_cast<DoubleLimb>(lhs[i]) + rhs[j];
+    lhs[i] = static_cast<Limb>(carry);
+    carry >>= kLimbBits;
   }
-  return digit_count;
-}
\ No newline at end of file
+  for (; carry > 0 && i < lhs.Size(); ++i) {
+    carry += lhs[i];
+    lhs[i] = static_cast<Limb>(carry);
+    carry >>= kLimbBits;
+  }
+  if (carry > 0) {
+    lhs.PushBack(static_cast<Limb>(carry));
+  }
+}
+
+void BigInteger::SubAbs(Limbs& lhs, const Limbs& rhs) {
+  SubAbs(lhs, rhs.Data(), rhs.Size());
+}
+
+// lhs -= rhs, where |lhs| >= |rhs|. rhs may point into lhs.
+void BigInteger::SubAbs(Limbs& lhs, const Limb* rhs, size_t rhs_size) {
+  Limb borrow = 0;
+  size_t i = 0;
+  for (; i < rhs_size; ++i) {
+    DoubleLimb difference = static_cast<DoubleLimb>(lhs[i]) - rhs[i] - borrow;
+    lhs[i] = static_cast<Limb>(difference);
+    borrow = static_cast<Limb>(difference >> (2 * kLimbBits - 1));
+  }
+  for (; borrow > 0 && i < lhs.Size(); ++i) {
+    borrow = lhs[i] == 0;
+    --lhs[i];
+  }
+}
+
+// lhs = rhs - lhs, where |rhs| > |lhs|, in place.
+void BigInteger::SubAbsFrom(Limbs& lhs, const Limb* rhs, size_t rhs_size) {
+  lhs.Resize(rhs_size, 0);
+  Limb borrow = 0;
+  for (size_t i = 0; i < rhs_size; ++i) {
+    DoubleLimb difference = static_cast<DoubleLimb>(rhs[i]) - lhs[i] - borrow;
+    lhs[i] = static_cast<Limb>(difference);
+    borrow = static_cast<Limb>(difference >> (2 * kLimbBits - 1));
+  }
+}
+
+// lhs += rhs * multiplier * 2^(32 * shift), in one pass over rhs.
+void BigInteger::AddMulLimb(Limbs& lhs, const Limbs& rhs, Limb multiplier, size_t shift) {
+  if (lhs.Size() < shift + rhs.Size()) {
+    lhs.Resize(shift + rhs.Size(), 0);
+  }
+  DoubleLimb carry = 0;
+  size_t i = shift;
+  for (size_t j = 0; j < rhs.Size(); ++i, ++j) {
+    carry += static_cast<DoubleLimb>(rhs[j]) * multiplier + lhs[i];
+    lhs[i] = static_cast<Limb>(carry);
+    carry >>= kLimbBits;
+  }
+  for (; carry > 0 && i < lhs.Size(); ++i) {
+    carry += lhs[i];
+    lhs[i] = static_cast<Limb>(carry);
+    carry >>= kLimbBits;
+  }
+  if (carry > 0) {
+    lhs.PushBack(static_cast<Limb>(carry));
+  }
+}
+
+BigInteger::MultiplicationThresholds BigInteger::multiplication_thresholds_ = {32, 192, 2048};
+size_t BigInteger::max_digits_ = kDefaultMaxDigits;
+std::unique_ptr<ThreadPool> BigInteger::multiplication_pool_;
+
+BigInteger::MultiplicationThresholds BigInteger::GetMultiplicationThresholds() {
+  return multiplication_thresholds_;
+}
+
+// Karatsuba and Toom-3 need a few limbs per part to make progress, so tiny thresholds are raised.
+void BigInteger::SetMultiplicationThresholds(MultiplicationThresholds thresholds) {
+  multiplication_thresholds_.karatsuba = std::max<size_t>(thresholds.karatsuba, 4);
+  multiplication_thresholds_.toom3 = std::max<size_t>(thresholds.toom3, 9);
+  multiplication_thresholds_.ntt = thresholds.ntt;
+}
+
+size_t BigInteger::GetMaxDigits() {
+  return max_digits_;
+}
+
+void BigInteger::SetMaxDigits(size_t digits) {
+  max_digits_ = digits;
+}
+
+size_t BigInteger::GetMultiplicationThreads() {
+  return multiplication_pool_ ? multiplication_pool_->Size() : 1;
+}
+
+void BigInteger::SetMultiplicationThreads(size_t threads) {
+  multiplication_pool_.reset();
+  if (threads > 1) {
+    multiplication_pool_ = std::make_unique<ThreadPool>(threads);
+  }
+}
+
+// Product of two trimmed magnitudes, trimmed. Picks the algorithm by the length of the shorter operand. Products too
+// long for one transform go through Toom-3 or the unbalanced split, whose smaller products come back here. Long
+// products are shared between the multiplication threads, unless this already runs on one of them.
+BigInteger::Limbs BigInteger::MulAbs(const Limbs& lhs, const Limbs& rhs) {
+  if (lhs.Size() < rhs.Size()) {
+    return MulAbs(rhs, lhs);
+  }
+  if (multiplication_pool_ && rhs.Size() >= kParallelMultiplicationThreshold && !ThreadPool::InWorker()) {
+    return MulParallel(lhs, rhs);
+  }
+  if (rhs.Size() < multiplication_thresholds_.karatsuba) {
+    return MulSchoolbook(lhs, rhs);
+  }
+  if (rhs.Size() >= multiplication_thresholds_.ntt && lhs.Size() + rhs.Size() <= kNttMaxLength) {
+    return MulNtt(lhs, rhs);
+  }
+  if (lhs.Size() >= 2 * rhs.Size()) {
+    return MulUnbalanced(lhs, rhs);
+  }
+  if (rhs.Size() < multiplication_thresholds_.toom3) {
+    return MulKaratsuba(lhs, rhs);
+  }
+  return MulToom3(lhs, rhs);
+}
+
+// Cuts the matrix of partial products into a grid of blocks, at least one per thread and as square as the operands
+// allow, since splitting a square product costs the least extra work. The blocks are multiplied on the pool by
+// MulAbs and added in at their offsets. The blocks read lhs and rhs, so all of them finish before this returns or
+// throws.
+BigInteger::Limbs BigInteger::MulParallel(const Limbs& lhs, const Limbs& rhs) {
+  const size_t threads = multiplication_pool_->Size();
+  size_t rows = 1;
+  size_t columns = 1;
+  while (rows * columns < threads) {
+    if (lhs.Size() / rows >= rhs.Size() / columns) {
+      ++rows;
+    } else {
+      ++columns;
+    }
+  }
+  const size_t row_length = (lhs.Size() + rows - 1) / rows;
+  const size_t column_length = (rhs.Size() + columns - 1) / columns;
+
+  std::vector<std::future<Limbs>> blocks;
+  blocks.reserve(rows * columns);
+  try {
+    for (size_t row = 0; row < rows; ++row) {
+      for (size_t column = 0; column < columns; ++column) {
+        blocks.push_back(multiplication_pool_->Submit([&lhs, &rhs, row, column, row_length, column_length] {
+          return MulAbs(Slice(lhs, row * row_length, (row + 1) * row_length),
+                        Slice(rhs, column * column_length, (column + 1) * column_length));
+        }));
+      }
+    }
+  } catch (...) {
+    WaitForAll(blocks);
+    throw;
+  }
+  WaitForAll(blocks);
+  Limbs result(lhs.Size() + rhs.Size(), 0);
+  for (size_t row = 0; row < rows; ++row) {
+    for (size_t column = 0; column < columns; ++column) {
+      AddAbsShifted(result, blocks[row * columns + column].get(), row * row_length + column * column_length);
+    }
+  }
+  TrimLimbs(result);
+  return result;
+}
+
+// Carries are propagated once per row rather than normalized after every partial product.
+BigInteger::Limbs BigInteger::MulSchoolbook(const Limbs& lhs, const Limbs& rhs) {
+  if (lhs.Empty() || rhs.Empty()) {
+    return {};
+  }
+  Limbs result(lhs.Size() + rhs.Size(), 0);
+  for (size_t i = 0; i < lhs.Size(); ++i) {
+    DoubleLimb carry = 0;
+    DoubleLimb multiplier = lhs[i];
+    for (size_t j = 0; j < rhs.Size(); ++j) {
+      carry += multiplier * rhs[j] + result[i + j];
+      result[i + j] = static_cast<Limb>(carry);
+      carry >>= kLimbBits;
+    }
+    result[i + rhs.Size()] = static_cast<Limb>(carry);
+  }
+  TrimLimbs(result);
+  return result;
+}
+
+// lhs is at least twice as long as rhs: multiplies rhs by lhs.Size() / rhs.Size() balanced pieces of lhs.
+BigInteger::Limbs BigInteger::MulUnbalanced(const Limbs& lhs, const Limbs& rhs) {
+  Limbs result;
+  for (size_t begin = 0; begin < lhs.Size(); begin += rhs.Size()) {
+    AddAbsShifted(result, MulAbs(Slice(lhs, begin, begin + rhs.Size()), rhs), begin);
+  }
+  TrimLimbs(result);
+  return result;
+}
+
+// With x = 2^(32 * half): (a1 x + a0)(b1 x + b0) = a1 b1 x^2 + ((a0 + a1)(b0 + b1) - a0 b0 - a1 b1) x + a0 b0.
+BigInteger::Limbs BigInteger::MulKaratsuba(const Limbs& lhs, const Limbs& rhs) {
+  size_t half = (lhs.Size() + 1) / 2;
+  Limbs a0 = Slice(lhs, 0, half);
+  Limbs a1 = Slice(lhs, half, lhs.Size());
+  Limbs b0 = Slice(rhs, 0, half);
+  Limbs b1 = Slice(rhs, half, rhs.Size());
+
+  Limbs low = MulAbs(a0, b0);
+  Limbs high = MulAbs(a1, b1);
+  AddAbs(a0, a1);
+  AddAbs(b0, b1);
+  Limbs middle = MulAbs(a0, b0);
+  SubAbs(middle, low);
+  SubAbs(middle, high);
+  TrimLimbs(middle);
+
+  Limbs result = std::move(low);
+  AddAbsShifted(result, middle, half);
+  AddAbsShifted(result, high, 2 * half);
+  TrimLimbs(result);
+  return result;
+}
+
+// Splits both operands in three parts, evaluates the part polynomials at 0, 1, -1, -2 and infinity, multiplies
+// pointwise and interpolates with Bodrato's sequence. Evaluations may be negative, so they are BigIntegers.
+BigInteger::Limbs BigInteger::MulToom3(const Limbs& lhs, const Limbs& rhs) {
+  size_t third = (lhs.Size() + 2) / 3;
+  auto part = [third](const Limbs& limbs, size_t index) {
+    BigInteger result;
+    result.limbs_ = Slice(limbs, index * third, (index + 1) * third);
+    return result;
+  };
+  auto evaluate = [&part](const Limbs& limbs) {
+    BigInteger p0 = part(limbs, 0);
+    BigInteger p1 = part(limbs, 1);
+    BigInteger p2 = part(limbs, 2);
+    BigInteger sum = p0 + p2;
+    BigInteger at_minus_one = sum - p1;
+    BigInteger at_minus_two = at_minus_one + p2;
+    at_minus_two += at_minus_two;
+    at_minus_two -= p0;
+    return std::vector<BigInteger>{p0, sum + p1, at_minus_one, at_minus_two, p2};
+  };
+  // A square evaluates its operand once and squares the evaluations.
+  const std::vector<BigInteger> p = evaluate(lhs);
+  const std::vector<BigInteger> q_values = &lhs == &rhs ? std::vector<BigInteger>() : evaluate(rhs);
+  const std::vector<BigInteger>& q = &lhs == &rhs ? p : q_values;
+  BigInteger r0 = MulUnlimited(p[0], q[0]);
+  BigInteger r1 = MulUnlimited(p[1], q[1]);
+  BigInteger r_minus_one = MulUnlimited(p[2], q[2]);
+  BigInteger r3 = MulUnlimited(p[3], q[3]);
+  BigInteger r_infinity = MulUnlimited(p[4], q[4]);
+
+  r3 -= r1;
+  r3.DivModSmall(3);
+  r1 -= r_minus_one;
+  r1.DivModSmall(2);
+  BigInteger r2 = r_minus_one - r0;
+  r3 = r2 - r3;
+  r3.DivModSmall(2);
+  r3 += r_infinity;
+  r3 += r_infinity;
+  r2 += r1;
+  r2 -= r_infinity;
+  r1 -= r3;
+
+  Limbs result = std::move(r0.limbs_);
+  AddAbsShifted(result, r1.limbs_, third);
+  AddAbsShifted(result, r2.limbs_, 2 * third);
+  AddAbsShifted(result, r3.limbs_, 3 * third);
+  AddAbsShifted(result, r_infinity.limbs_, 4 * third);
+  TrimLimbs(result);
+  return result;
+}
+
+// Signed product that skips the digit limit, for intermediate values of algorithms whose results respect it. A value
+// times itself is squared.
+BigInteger BigInteger::MulUnlimited(const BigInteger& lhs, const BigInteger& rhs) {
+  BigInteger result;
+  result.limbs_ = &lhs == &rhs ? SqrAbs(lhs.limbs_) : MulAbs(lhs.limbs_, rhs.limbs_);
+  result.is_negative_ = lhs.is_negative_ != rhs.is_negative_;
+  result.Trim();
+  return result;
+}
+
+// Square of a trimmed magnitude, trimmed. The schoolbook and Karatsuba kernels save close to half of the limb
+// multiplications of their MulAbs counterparts; longer squares go through MulAbs(value, value), whose Toom-3 and
+// transform steps notice the shared operand.
+BigInteger::Limbs BigInteger::SqrAbs(const Limbs& value) {
+  if (value.Size() < multiplication_thresholds_.karatsuba) {
+    return SqrSchoolbook(value);
+  }
+  if (value.Size() < multiplication_thresholds_.toom3) {
+    return SqrKaratsuba(value);
+  }
+  return MulAbs(value, value);
+}
+
+// Every cross product a_i a_j, i < j, is computed once, the sum of them is doubled with a shift, and the squares
+// a_i^2 are added on the diagonal.
+BigInteger::Limbs BigInteger::SqrSchoolbook(const Limbs& value) {
+  const size_t n = value.Size();
+  if (n == 0) {
+    return {};
+  }
+  Limbs result(2 * n, 0);
+  for (size_t i = 0; i + 1 < n; ++i) {
+    DoubleLimb carry = 0;
+    DoubleLimb multiplier = value[i];
+    for (size_t j = i + 1; j < n; ++j) {
+      carry += multiplier * value[j] + result[i + j];
+      result[i + j] = static_cast<Limb>(carry);
+      carry >>= kLimbBits;
+    }
+    result[i + n] = static_cast<Limb>(carry);
+  }
+  ShiftLeftBits(result, 1);
+  DoubleLimb carry = 0;
+  for (size_t i = 0; i < n; ++i) {
+    DoubleLimb square = static_cast<DoubleLimb>(value[i]) * value[i];
+    carry += static_cast<Limb>(square) + static_cast<DoubleLimb>(result[2 * i]);
+    result[2 * i] = static_cast<Limb>(carry);
+    carry >>= kLimbBits;
+    carry += (square >> kLimbBits) + result[2 * i + 1];
+    result[2 * i + 1] = static_cast<Limb>(carry);
+    carry >>= kLimbBits;
+  }
+  TrimLimbs(result);
+  return result;
+}
+
+// (a1 x + a0)^2 = a1^2 x^2 + ((a0 + a1)^2 - a0^2 - a1^2) x + a0^2: three squares of half the length.
+BigInteger::Limbs BigInteger::SqrKaratsuba(const Limbs& value) {
+  size_t half = (value.Size() + 1) / 2;
+  Limbs a0 = Slice(value, 0, half);
+  Limbs a1 = Slice(value, half, value.Size());
+
+  Limbs low = SqrAbs(a0);
+  Limbs high = SqrAbs(a1);
+  AddAbs(a0, a1);
+  Limbs middle = SqrAbs(a0);
+  SubAbs(middle, low);
+  SubAbs(middle, high);
+  TrimLimbs(middle);
+
+  Limbs result = std::move(low);
+  AddAbsShifted(result, middle, half);
+  AddAbsShifted(result, high, 2 * half);
+  TrimLimbs(result);
+  return result;
+}
+
+// Three NTT-friendly primes c * 2^k + 1, all with primitive root 3. Their product exceeds 2^86, which bounds every
+// coefficient of a convolution of up to 2^22 pairs of 32-bit limbs, so the coefficients are recovered exactly by CRT.
+// The transforms take the prime as a template argument so that reductions compile to multiplications.
+constexpr uint32_t kNttModuli[3] = {998244353, 167772161, 469762049};
+constexpr uint32_t kNttRoot = 3;
+
+template <uint32_t kModulus>
+uint32_t NttPowMod(uint64_t base, uint64_t exponent) {
+  uint64_t result = 1;
+  base %= kModulus;
+  for (; exponent > 0; exponent >>= 1) {
+    if (exponent & 1) {
+      result = result * base % kModulus;
+    }
+    base = base * base % kModulus;
+  }
+  return static_cast<uint32_t>(result);
+}
+
+// In-place iterative radix-2 transform of a power-of-two length, the inverse one including the division by the length.
+template <uint32_t kModulus>
+void Ntt(std::vector<uint32_t>& values, bool inverse) {
+  const size_t size = values.size();
+  for (size_t i = 1, j = 0; i < size; ++i) {
+    size_t bit = size >> 1;
+    for (; j & bit; bit >>= 1) {
+      j ^= bit;
+    }
+    j ^= bit;
+    if (i < j) {
+      std::swap(values[i], values[j]);
+    }
+  }
+  std::vector<uint32_t> twiddles(std::max<size_t>(size / 2, 1));
+  for (size_t length = 2; length <= size; length <<= 1) {
+    uint64_t step = NttPowMod<kModulus>(kNttRoot, (kModulus - 1) / length);
+    if (inverse) {
+      step = NttPowMod<kModulus>(step, kModulus - 2);
+    }
+    size_t half = length / 2;
+    twiddles[0] = 1;
+    for (size_t k = 1; k < half; ++k) {
+      twiddles[k] = static_cast<uint32_t>(twiddles[k - 1] * step % kModulus);
+    }
+    for (size_t start = 0; start < size; start += length) {
+      uint32_t* low = values.data() + start;
+      uint32_t* high = low + half;
+      for (size_t k = 0; k < half; ++k) {
+        uint32_t u = low[k];
+        uint32_t v = static_cast<uint32_t>(static_cast<uint64_t>(high[k]) * twiddles[k] % kModulus);
+        low[k] = u + v >= kModulus ? u + v - kModulus : u + v;
+        high[k] = u >= v ? u - v : u + kModulus - v;
+      }
+    }
+  }
+  if (inverse) {
+    uint64_t scale = NttPowMod<kModulus>(size, kModulus - 2);
+    for (uint32_t& value : values) {
+      value = static_cast<uint32_t>(value * scale % kModulus);
+    }
+  }
+}
+
+// Cyclic convolution of lhs and rhs of the given power-of-two length, modulo kModulus. A square takes one forward
+// transform instead of two.
+template <uint32_t kModulus>
+std::vector<uint32_t> ConvolutionModulo(const LimbVector& lhs, const LimbVector& rhs,
+                                        size_t length) {
+  std::vector<uint32_t> a(length, 0);
+  std::vector<uint32_t> b(length, 0);
+  for (size_t i = 0; i < lhs.Size(); ++i) {
+    a[i] = lhs[i] % kModulus;
+  }
+  for (size_t i = 0; i < rhs.Size() && &lhs != &rhs; ++i) {
+    b[i] = rhs[i] % kModulus;
+  }
+  Ntt<kModulus>(a, false);
+  if (&lhs == &rhs) {
+    b = a;
+  } else {
+    Ntt<kModulus>(b, false);
+  }
+  for (size_t i = 0; i < length; ++i) {
+    a[i] = static_cast<uint32_t>(static_cast<uint64_t>(a[i]) * b[i] % kModulus);
+  }
+  Ntt<kModulus>(a, true);
+  return a;
+}
+
+// Convolves the limbs modulo each prime, then rebuilds every coefficient x = r0 + m0 * s + m0 * m1 * t by Garner's
+// algorithm and adds it in at its limb. x can reach 2^86, so m0 * m1 * t is split into 32-bit halves and the running
+// carry stays below 2^57.
+BigInteger::Limbs BigInteger::MulNtt(const Limbs& lhs, const Limbs& rhs) {
+  const size_t coefficients = lhs.Size() + rhs.Size() - 1;
+  size_t length = 1;
+  while (length < coefficients) {
+    length <<= 1;
+  }
+  const std::vector<uint32_t> residues[3] = {ConvolutionModulo<kNttModuli[0]>(lhs, rhs, length),
+                                              ConvolutionModulo<kNttModuli[1]>(lhs, rhs, length),
+                                              ConvolutionModulo<kNttModuli[2]>(lhs, rhs, length)};
+
+  const uint64_t m0 = kNttModuli[0];
+  const uint64_t m1 = kNttModuli[1];
+  const uint64_t m2 = kNttModuli[2];
+  const uint64_t m01 = m0 * m1;
+  const uint64_t m0_inverse = NttPowMod<kNttModuli[1]>(m0, m1 - 2);
+  const uint64_t m01_inverse = NttPowMod<kNttModuli[2]>(m01, m2 - 2);
+  const uint64_t low_mask = 0xFFFFFFFF;
+
+  Limbs result(lhs.Size() + rhs.Size(), 0);
+  DoubleLimb carry = 0;
+  for (size_t i = 0; i < result.Size(); ++i) {
+    uint64_t value = 0;
+    uint64_t t = 0;
+    if (i < coefficients) {
+      uint64_t r0 = residues[0][i];
+      uint64_t s = (residues[1][i] + m1 - r0 % m1) % m1 * m0_inverse % m1;
+      value = r0 + m0 * s;
+      t = (residues[2][i] + m2 - value % m2) % m2 * m01_inverse % m2;
+    }
+    uint64_t high_product = (m01 >> kLimbBits) * t;
+    uint64_t low_product = (m01 & low_mask) * t;
+    uint64_t sum = value + carry;
+    uint64_t low = (sum & low_mask) + (low_product & low_mask);
+    result[i] = static_cast<Limb>(low);
+    carry = (sum >> kLimbBits) + (low_product >> kLimbBits) + high_product + (low >> kLimbBits);
+  }
+  TrimLimbs(result);
+  return result;
+}
+
+// 10^exponent by binary powering, without the digit limit.
+BigInteger::Limbs BigInteger::PowerOfTen(size_t exponent) {
+  Limbs result = {1};
+  Limbs base = {10};
+  for (; exponent > 0; exponent >>= 1) {
+    if (exponent & 1) {
+      result = MulAbs(result, base);
+    }
+    if (exponent > 1) {
+      base = SqrAbs(base);
+    }
+  }
+  return result;
+}
+
+// Divides limbs by divisor in place, leaving them trimmed, and returns the remainder.
+BigInteger::Limb BigInteger::DivModLimb(Limbs& limbs, Limb divisor) {
+  DoubleLimb remainder = 0;
+  for (size_t i = limbs.Size(); i-- > 0;) {
+    DoubleLimb current = (remainder << kLimbBits) | limbs[i];
+    limbs[i] = static_cast<Limb>(current / divisor);
+    remainder = current % divisor;
+  }
+  TrimLimbs(limbs);
+  return static_cast<Limb>(remainder);
+}
+
+// limbs <<= bits for 0 <= bits < 32.
+void BigInteger::ShiftLeftBits(Limbs& limbs, int bits) {
+  if (bits == 0 || limbs.Empty()) {
+    return;
+  }
+  Limb carry = 0;
+  for (Limb& limb : limbs) {
+    Limb next = limb >> (kLimbBits - bits);
+    limb = (limb << bits) | carry;
+    carry = next;
+  }
+  if (carry > 0) {
+    limbs.PushBack(carry);
+  }
+}
+
+// limbs >>= bits for 0 <= bits < 32.
+void BigInteger::ShiftRightBits(Limbs& limbs, int bits) {
+  if (bits == 0 || limbs.Empty()) {
+    return;
+  }
+  for (size_t i = 0; i + 1 < limbs.Size(); ++i) {
+    limbs[i] = (limbs[i] >> bits) | (limbs[i + 1] << (kLimbBits - bits));
+  }
+  limbs.Back() >>= bits;
+  TrimLimbs(limbs);
+}
+
+// Quotient and remainder of two trimmed magnitudes, rhs nonzero. Both operands are first shifted left so that the top
+// bit of the divisor is set, which the long division algorithms rely on to estimate quotient limbs.
+void BigInteger::DivModAbs(const Limbs& lhs, const Limbs& rhs, Limbs& quotient, Limbs& remainder) {
+  if (CompareAbs(lhs, rhs) < 0) {
+    quotient.Clear();
+    remainder = lhs;
+    return;
+  }
+  if (rhs.Size() == 1) {
+    quotient = lhs;
+    Limb rest = DivModLimb(quotient, rhs[0]);
+    remainder.Assign(rest > 0 ? 1 : 0, rest);
+    return;
+  }
+  const int shift = kLimbBits - LimbBitLength(rhs.Back());
+  Limbs dividend = lhs;
+  Limbs divisor = rhs;
+  ShiftLeftBits(dividend, shift);
+  ShiftLeftBits(divisor, shift);
+
+  const size_t n = divisor.Size();
+  if (n < kDivisionRecursionThreshold) {
+    DivModKnuth(dividend, divisor, quotient, remainder);
+  } else {
+    // Long division in base 2^(32 n): every step divides fewer than 2n limbs by the n-limb divisor.
+    quotient.Clear();
+    remainder.Clear();
+    for (size_t block = (dividend.Size() - 1) / n + 1; block-- > 0;) {
+      Limbs current = Slice(dividend, block * n, (block + 1) * n);
+      AddAbsShifted(current, remainder, n);
+      Limbs digit;
+      DivModRecursive(current, divisor, digit, remainder);
+      AddAbsShifted(quotient, digit, block * n);
+    }
+    TrimLimbs(quotient);
+  }
+  ShiftRightBits(remainder, shift);
+}
+
+// Knuth's algorithm D (TAOCP 4.3.1) for a normalized divisor of at least two limbs: each quotient limb is estimated
+// from the top two dividend limbs, corrected with the next one, and is then off by at most one, which the rare
+// add-back step fixes.
+void BigInteger::DivModKnuth(const Limbs& lhs, const Limbs& rhs, Limbs& quotient, Limbs& remainder) {
+  const size_t n = rhs.Size();
+  if (CompareAbs(lhs, rhs) < 0) {
+    quotient.Clear();
+    remainder = lhs;
+    return;
+  }
+  if (n == 1) {
+    quotient = lhs;
+    Limb rest = DivModLimb(quotient, rhs[0]);
+    remainder.Assign(rest > 0 ? 1 : 0, rest);
+    return;
+  }
+  const DoubleLimb base = DoubleLimb{1} << kLimbBits;
+  const DoubleLimb top = rhs[n - 1];
+  const DoubleLimb next = rhs[n - 2];
+  Limbs u = lhs;
+  u.PushBack(0);
+  quotient.Assign(lhs.Size() - n + 1, 0);
+  for (size_t j = quotient.Size(); j-- > 0;) {
+    DoubleLimb numerator = (static_cast<DoubleLimb>(u[j + n]) << kLimbBits) | u[j + n - 1];
+    DoubleLimb estimate = numerator / top;
+    DoubleLimb rest = numerator % top;
+    while (estimate >= base || estimate * next > ((rest << kLimbBits) | u[j + n - 2])) {
+      --estimate;
+      rest += top;
+      if (rest >= base) {
+        break;
+      }
+    }
+
+    int64_t borrow = 0;
+    for (size_t i = 0; i < n; ++i) {
+      DoubleLimb product = estimate * rhs[i];
+      int64_t difference = static_cast<int64_t>(u[i + j]) - borrow - static_cast<int64_t>(product & (base - 1));
+      u[i + j] = static_cast<Limb>(difference);
+      borrow = static_cast<int64_t>(product >> kLimbBits) - (difference >> kLimbBits);
+    }
+    int64_t difference = static_cast<int64_t>(u[j + n]) - borrow;
+    u[j + n] = static_cast<Limb>(difference);
+
+    if (difference < 0) {
+      --estimate;
+      DoubleLimb carry = 0;
+      for (size_t i = 0; i < n; ++i) {
+        carry += static_cast<DoubleLimb>(u[i + j]) + rhs[i];
+        u[i + j] = static_cast<Limb>(carry);
+        carry >>= kLimbBits;
+      }
+      u[j + n] += static_cast<Limb>(carry);
+    }
+    quotient[j] = static_cast<Limb>(estimate);
+  }
+  TrimLimbs(quotient);
+  u.Resize(n);
+  TrimLimbs(u);
+  remainder = std::move(u);
+}
+
+// Recursive division of Burnikel and Ziegler, in the form of Brent and Zimmermann's RecursiveDivRem: lhs has at most
+// n + m limbs for the normalized n-limb divisor rhs and m <= n. With k = m / 2, the top of lhs is divided by the top
+// n - k limbs of rhs twice, k quotient limbs at a time, and the low limbs of rhs are accounted for by a
+// multiplication, so the cost follows that of MulAbs.
+void BigInteger::DivModRecursive(const Limbs& lhs, const Limbs& rhs, Limbs& quotient, Limbs& remainder) {
+  const size_t n = rhs.Size();
+  const size_t m = lhs.Size() > n ? lhs.Size() - n : 0;
+  if (m + 2 < n) {
+    // A short quotient depends on the low limbs of a long divisor only through a small correction: dividing the top
+    // 2m + 2 limbs by the top m + 2 overestimates it by at most a few units, which one multiplication fixes.
+    const size_t dropped = n - m - 2;
+    DivModRecursive(Slice(lhs, dropped, lhs.Size()), Limbs(rhs.begin() + dropped, rhs.end()), quotient, remainder);
+    Limbs product = MulAbs(quotient, rhs);
+    while (CompareAbs(lhs, product) < 0) {
+      SubAbs(quotient, {1});
+      TrimLimbs(quotient);
+      SubAbs(product, rhs);
+      TrimLimbs(product);
+    }
+    remainder = lhs;
+    SubAbs(remainder, product);
+    TrimLimbs(remainder);
+    return;
+  }
+  if (m < kDivisionRecursionThreshold) {
+    DivModKnuth(lhs, rhs, quotient, remainder);
+    return;
+  }
+  const size_t k = m / 2;
+  const Limbs low = Slice(rhs, 0, k);
+  const Limbs high(rhs.begin() + k, rhs.end());
+
+  // Divides (rest * 2^(32 (k + shift)) + lhs limbs [shift, shift + k)) by rhs * 2^(32 shift); shift is k for the
+  // first half of the quotient and 0 for the second, whose dividend is the first remainder.
+  auto half_step = [&](const Limbs& top, const Limbs& below, size_t shift, Limbs& digits, Limbs& rest) {
+    DivModRecursive(top, high, digits, rest);
+    Limbs value = Slice(below, 0, shift + k);
+    AddAbsShifted(value, rest, shift + k);
+    Limbs correction;
+    AddAbsShifted(correction, MulAbs(digits, low), shift);
+    while (CompareAbs(value, correction) < 0) {
+      AddAbsShifted(value, rhs, shift);
+      SubAbs(digits, {1});
+      TrimLimbs(digits);
+    }
+    SubAbs(value, correction);
+    TrimLimbs(value);
+    rest = std::move(value);
+  };
+
+  Limbs first_digits;
+  Limbs first_rest;
+  half_step(Slice(lhs, 2 * k, lhs.Size()), lhs, k, first_digits, first_rest);
+  Limbs second_digits;
+  half_step(Slice(first_rest, k, first_rest.Size()), first_rest, 0, second_digits, remainder);
+  quotient = std::move(second_digits);
+  AddAbsShifted(quotient, first_digits, k);
+  TrimLimbs(quotient);
+}
+
+// 10^(9 * 2^level), built by repeated squaring on first use and kept, so that conversions of similar sizes share them.
+// References stay valid as the deque grows.
+const BigInteger::Limbs& BigInteger::DecimalPower(size_t level) {
+  static std::mutex mutex;
+  static std::deque<Limbs> powers;
+  std::lock_guard<std::mutex> lock(mutex);
+  if (powers.empty()) {
+    powers.push_back({kDecimalChunk});
+  }
+  while (powers.size() <= level) {
+    powers.push_back(SqrAbs(powers.back()));
+  }
+  return powers[level];
+}
+
+// Value of count decimal digits. Short inputs go through Horner's scheme over chunks of nine digits; longer ones are
+// split so that the low part is 9 * 2^level digits long, and the parts are joined with one multiplication by a cached
+// power of ten, which makes the conversion as fast as multiplication rather than quadratic.
+BigInteger::Limbs BigInteger::ParseDecimal(const char* digits, size_t count) {
+  if (count <= kDecimalChunkDigits * kDecimalRecursionChunks) {
+    Limbs result;
+    // The first chunk takes the remainder so the rest are full.
+    size_t chunk_size = count % kDecimalChunkDigits;
+    if (chunk_size == 0) {
+      chunk_size = kDecimalChunkDigits;
+    }
+    for (size_t pos = 0; pos < count; pos += chunk_size, chunk_size = kDecimalChunkDigits) {
+      Limb chunk = 0;
+      Limb scale = 1;
+      for (size_t i = pos; i < pos + chunk_size; ++i) {
+        chunk = chunk * 10 + (digits[i] - '0');
+        scale *= 10;
+      }
+      MulAddLimb(result, scale, chunk);
+    }
+    TrimLimbs(result);
+    return result;
+  }
+  size_t level = 0;
+  while (size_t{kDecimalChunkDigits} << (level + 1) < count) {
+    ++level;
+  }
+  const size_t low_count = size_t{kDecimalChunkDigits} << level;
+  Limbs result = MulAbs(ParseDecimal(digits, count - low_count), DecimalPower(level));
+  AddAbs(result, ParseDecimal(digits + count - low_count, low_count));
+  TrimLimbs(result);
+  return result;
+}
+
+// Writes value < 10^(9 * 2^level) from the most significant digit on and returns the end of the output. With pad the
+// output is exactly 9 * 2^level digits, with leading zeros; otherwise it has none. Large values are split by the
+// cached power of ten of the level below, the quotient giving the high digits and the remainder the padded low ones.
+char* BigInteger::WriteDecimal(const Limbs& value, size_t level, bool pad, char* out) {
+  if (value.Size() > kDecimalRecursionChunks && level > 0) {
+    Limbs high;
+    Limbs low;
+    DivModAbs(value, DecimalPower(level - 1), high, low);
+    if (pad || !high.Empty()) {
+      out = WriteDecimal(high, level - 1, pad, out);
+      pad = true;
+    }
+    return WriteDecimal(low, level - 1, pad, out);
+  }
+  // Nine digits at a time, least significant chunk first, into a scratch buffer.
+  Limbs rest = value;
+  Limbs chunks;
+  while (!rest.Empty()) {
+    chunks.PushBack(DivModLimb(rest, kDecimalChunk));
+  }
+  if (pad) {
+    chunks.Resize(size_t{1} << level, 0);
+  } else if (chunks.Empty()) {
+    *out = '0';
+    return out + 1;
+  }
+  for (size_t i = chunks.Size(); i-- > 0;) {
+    char digits[kDecimalChunkDigits];
+    Limb chunk = chunks[i];
+    for (int j = kDecimalChunkDigits; j-- > 0;) {
+      digits[j] = static_cast<char>('0' + chunk % 10);
+      chunk /= 10;
+    }
+    int skip = 0;
+    if (!pad && i + 1 == chunks.Size()) {
+      while (skip + 1 < kDecimalChunkDigits && digits[skip] == '0') {
+        ++skip;
+      }
+    }
+    std::copy(digits + skip, digits + kDecimalChunkDigits, out);
+    out += kDecimalChunkDigits - skip;
+  }
+  return out;
+}
+
+// value mod modulus in [0, modulus) for a trimmed nonzero modulus.
+BigInteger::Limbs BigInteger::Residue(const BigInteger& value, const Limbs& modulus) {
+  Limbs quotient;
+  Limbs remainder;
+  DivModAbs(value.limbs_, modulus, quotient, remainder);
+  if (value.is_negative_ && !remainder.Empty()) {
+    SubAbsFrom(remainder, modulus.Data(), modulus.Size());
+    TrimLimbs(remainder);
+  }
+  return remainder;
+}
+
+// base^exponent for a nonzero exponent, given the product and square of the residue ring. The exponent is scanned from
+// the top bit; a window of up to w bits that ends with a set bit costs its squarings and one multiplication by a
+// precomputed odd power base^1, base^3, ..., base^(2^w - 1), so an e-bit exponent takes about e squarings and
+// e / (w + 1) multiplications. The window widths by exponent length are those of OpenSSL's BN_mod_exp.
+template <class Multiply, class Square>
+BigInteger::Limbs BigInteger::PowerSlidingWindow(const Limbs& base, const Limbs& exponent, Multiply multiply,
+                                                 Square square) {
+  auto bit = [&exponent](size_t index) {
+    return (exponent[index / kLimbBits] >> (index % kLimbBits)) & 1;
+  };
+  size_t bits = exponent.Size() * kLimbBits;
+  while (!bit(bits - 1)) {
+    --bits;
+  }
+  const size_t window = bits > 671 ? 6 : bits > 239 ? 5 : bits > 79 ? 4 : bits > 23 ? 3 : 1;
+
+  std::vector<Limbs> odd_powers(size_t{1} << (window - 1));
+  odd_powers[0] = base;
+  if (odd_powers.size() > 1) {
+    const Limbs base_squared = square(base);
+    for (size_t i = 1; i < odd_powers.size(); ++i) {
+      odd_powers[i] = multiply(odd_powers[i - 1], base_squared);
+    }
+  }
+
+  Limbs result;
+  for (size_t i = bits; i > 0;) {
+    if (!bit(i - 1)) {
+      result = square(result);
+      --i;
+      continue;
+    }
+    size_t length = std::min(window, i);
+    while (!bit(i - length)) {
+      --length;
+    }
+    size_t digit = 0;
+    for (size_t j = 1; j <= length; ++j) {
+      digit = (digit << 1) | bit(i - j);
+    }
+    if (i == bits) {
+      result = odd_powers[digit >> 1];
+    } else {
+      for (size_t j = 0; j < length; ++j) {
+        result = square(result);
+      }
+      result = multiply(result, odd_powers[digit >> 1]);
+    }
+    i -= length;
+  }
+  return result;
+}
+
+BigInteger PowMod(const BigInteger& base, const BigInteger& exponent, const BigInteger& modulus) {
+  if (!modulus) {
+    throw BigIntegerDivisionByZero();
+  }
+  if (exponent.is_negative_) {
+    throw BigIntegerDomainError("PowMod needs a non-negative exponent");
+  }
+  const BigInteger abs_modulus = modulus.Abs();
+  if (abs_modulus.limbs_[0] & 1) {
+    return MontgomeryContext(abs_modulus).PowMod(base, exponent);
+  }
+  const BigInteger::Limbs& m = abs_modulus.limbs_;
+  BigInteger result;
+  if (!exponent) {
+    result.limbs_ = {1};
+    return result;
+  }
+  auto reduce = [&m](const BigInteger::Limbs& value) {
+    BigInteger::Limbs quotient;
+    BigInteger::Limbs remainder;
+    BigInteger::DivModAbs(value, m, quotient, remainder);
+    return remainder;
+  };
+  result.limbs_ = BigInteger::PowerSlidingWindow(
+      BigInteger::Residue(base, m), exponent.limbs_,
+      [&reduce](const BigInteger::Limbs& lhs, const BigInteger::Limbs& rhs) {
+        return reduce(BigInteger::MulAbs(lhs, rhs));
+      },
+      [&reduce](const BigInteger::Limbs& value) { return reduce(BigInteger::SqrAbs(value)); });
+  return result;
+}
+
+// inverse_ comes from Newton's iteration x <- x (2 - m x), which doubles the number of correct low bits of 1 / m
+// starting from x = m, right to three bits for odd m; R^2 mod m takes one long division.
+MontgomeryContext::MontgomeryContext(const BigInteger& modulus) : modulus_(modulus) {
+  if (modulus_.is_negative_ || !modulus_ || !(modulus_.limbs_[0] & 1)) {
+    throw BigIntegerDomainError("MontgomeryContext needs an odd positive modulus");
+  }
+  const Limb low = modulus_.limbs_[0];
+  Limb x = low;
+  for (int i = 0; i < 4; ++i) {
+    x *= 2 - low * x;
+  }
+  inverse_ = 0 - x;
+
+  const size_t n = modulus_.limbs_.Size();
+  Limbs r_power(2 * n + 1, 0);
+  r_power.Back() = 1;
+  Limbs quotient;
+  BigInteger::DivModAbs(r_power, modulus_.limbs_, quotient, r_squared_);
+}
+
+const BigInteger& MontgomeryContext::Modulus() const {
+  return modulus_;
+}
+
+BigInteger MontgomeryContext::ToMontgomery(const BigInteger& value) const {
+  BigInteger result;
+  result.limbs_ = BigInteger::MulAbs(BigInteger::Residue(value, modulus_.limbs_), r_squared_);
+  Reduce(result.limbs_);
+  return result;
+}
+
+BigInteger MontgomeryContext::FromMontgomery(const BigInteger& value) const {
+  BigInteger result = value;
+  Reduce(result.limbs_);
+  return result;
+}
+
+BigInteger MontgomeryContext::Multiply(const BigInteger& lhs, const BigInteger& rhs) const {
+  BigInteger result;
+  result.limbs_ = BigInteger::MulAbs(lhs.limbs_, rhs.limbs_);
+  Reduce(result.limbs_);
+  return result;
+}
+
+BigInteger MontgomeryContext::Square(const BigInteger& value) const {
+  BigInteger result;
+  result.limbs_ = BigInteger::SqrAbs(value.limbs_);
+  Reduce(result.limbs_);
+  return result;
+}
+
+BigInteger MontgomeryContext::PowMod(const BigInteger& base, const BigInteger& exponent) const {
+  if (exponent.is_negative_) {
+    throw BigIntegerDomainError("PowMod needs a non-negative exponent");
+  }
+  if (!exponent) {
+    return FromMontgomery(ToMontgomery(1));
+  }
+  BigInteger result;
+  result.limbs_ = BigInteger::PowerSlidingWindow(
+      ToMontgomery(base).limbs_, exponent.limbs_,
+      [this](const Limbs& lhs, const Limbs& rhs) {
+        Limbs product = BigInteger::MulAbs(lhs, rhs);
+        Reduce(product);
+        return product;
+      },
+      [this](const Limbs& value) {
+        Limbs square = BigInteger::SqrAbs(value);
+        Reduce(square);
+        return square;
+      });
+  Reduce(result.limbs_);
+  return result;
+}
+
+// value = value / R mod m for value < m R (REDC): adding u m with u = -value / m mod 2^32 clears the lowest limb, n
+// times over, and the result, below 2m, takes at most one subtraction of m.
+void MontgomeryContext::Reduce(Limbs& value) const {
+  const Limbs& m = modulus_.limbs_;
+  const size_t n = m.Size();
+  // Limb 2n of the sum, at most 1, is kept apart so that a product needs no reallocation.
+  value.Resize(2 * n, 0);
+  Limb top = 0;
+  for (size_t i = 0; i < n; ++i) {
+    const DoubleLimb u = static_cast<Limb>(value[i] * inverse_);
+    DoubleLimb carry = 0;
+    for (size_t j = 0; j < n; ++j) {
+      carry += u * m[j] + value[i + j];
+      value[i + j] = static_cast<Limb>(carry);
+      carry >>= BigInteger::kLimbBits;
+    }
+    for (size_t k = i + n; carry > 0 && k < 2 * n; ++k) {
+      carry += value[k];
+      value[k] = static_cast<Limb>(carry);
+      carry >>= BigInteger::kLimbBits;
+    }
+    top += static_cast<Limb>(carry);
+  }
+  std::copy(value.begin() + n, value.end(), value.begin());
+  value.Resize(n);
+  value.PushBack(top);
+  BigInteger::TrimLimbs(value);
+  if (BigInteger::CompareAbs(value, m) >= 0) {
+    BigInteger::SubAbs(value, m);
+    BigInteger::TrimLimbs(value);
+  }
+}
+
+// Left to right binary powering: the squares go through the squaring kernels and the multiplications are by base
+// itself, which is short next to the partial result. The partial results never exceed |base^exponent|, so the digit
+// limit is only hit when the result itself is too long.
+BigInteger Pow(const BigInteger& base, uint64_t exponent) {
+  if (exponent == 0) {
+    return 1;
+  }
+  int top = 63;
+  while (!((exponent >> top) & 1)) {
+    --top;
+  }
+  BigInteger result = base;
+  for (int bit = top - 1; bit >= 0; --bit) {
+    result *= result;
+    if ((exponent >> bit) & 1) {
+      result *= base;
+    }
+  }
+  return result;
+}
+
+// Values of up to 64 bits start from the floating-point root. Longer ones recurse on the top half of their bits: if r
+// is the root of value / 4^s, then x = r 2^s is below the root of value by less than 2^s, and one Newton step
+// (x + value / x) / 2 brings that error under one whenever 2^s does not exceed r. Newton steps never fall below the
+// root, so at most a few decrements are left, and the whole costs about one division of value by its root.
+BigInteger ISqrt(const BigInteger& value) {
+  if (value.is_negative_) {
+    throw BigIntegerDomainError("ISqrt needs a non-negative value");
+  }
+  const size_t bits = value.BitLength();
+  if (bits <= 64) {
+    const uint64_t n = value.limbs_.Empty() ? 0
+                       : value.limbs_.Size() == 1
+                           ? value.limbs_[0]
+                           : (static_cast<uint64_t>(value.limbs_[1]) << BigInteger::kLimbBits) | value.limbs_[0];
+    auto root = static_cast<uint64_t>(std::sqrt(static_cast<double>(n)));
+    while (root > 0xFFFFFFFF || root * root > n) {
+      --root;
+    }
+    while (root < 0xFFFFFFFF && (root + 1) * (root + 1) <= n) {
+      ++root;
+    }
+    return static_cast<int64_t>(root);
+  }
+  const size_t shift = bits / 4;
+  BigInteger root = ISqrt(value >> (2 * shift)) << shift;
+  root += value / root;
+  root >>= 1;
+  while (BigInteger::MulUnlimited(root, root) > value) {
+    --root;
+  }
+  return root;
+}
+
+// Single words use Stein's binary algorithm. Longer operands take Lehmer steps, and from kGcdRecursionThreshold limbs
+// on a half-GCD of their leading two thirds reduces them by about a third of their length at the cost of a few
+// multiplications, which makes the whole subquadratic. Operands of very different lengths first take a division.
+BigInteger Gcd(const BigInteger& lhs, const BigInteger& rhs) {
+  BigInteger a = lhs.Abs();
+  BigInteger b = rhs.Abs();
+  if (a < b) {
+    std::swap(a, b);
+  }
+  int determinant = 1;
+  while (b.limbs_.Size() > 2) {
+    const size_t n = a.limbs_.Size();
+    if (n > b.limbs_.Size() + 1) {
+      BigInteger::DivisionStep(a, b, nullptr, determinant);
+    } else if (n < BigInteger::kGcdRecursionThreshold) {
+      BigInteger::LehmerStep(a, b, nullptr, determinant);
+    } else {
+      const size_t shift = n / 3 * BigInteger::kLimbBits;
+      BigInteger a_top = a >> shift;
+      BigInteger b_top = b >> shift;
+      BigInteger matrix[2][2];
+      int matrix_determinant = BigInteger::HalfGcd(a_top, b_top, matrix);
+      BigInteger::ApplyInverse(a, b, matrix, matrix_determinant);
+      if (b) {
+        BigInteger::DivisionStep(a, b, nullptr, determinant);
+      }
+    }
+  }
+  if (b && a.limbs_.Size() > 2) {
+    BigInteger::DivisionStep(a, b, nullptr, determinant);
+  }
+  if (!b) {
+    return a;
+  }
+
+  auto word = [](const BigInteger& value) {
+    uint64_t result = 0;
+    for (size_t i = value.limbs_.Size(); i-- > 0;) {
+      result = (result << BigInteger::kLimbBits) | value.limbs_[i];
+    }
+    return result;
+  };
+  uint64_t x = word(a);
+  uint64_t y = word(b);
+  auto from_word = [](uint64_t value) {
+    BigInteger result;
+    result.limbs_ = {static_cast<BigInteger::Limb>(value),
+                     static_cast<BigInteger::Limb>(value >> BigInteger::kLimbBits)};
+    result.Trim();
+    return result;
+  };
+  int common = 0;
+  for (; ((x | y) & 1) == 0; ++common) {
+    x >>= 1;
+    y >>= 1;
+  }
+  while ((x & 1) == 0) {
+    x >>= 1;
+  }
+  while (y != 0) {
+    while ((y & 1) == 0) {
+      y >>= 1;
+    }
+    if (x > y) {
+      std::swap(x, y);
+    }
+    y -= x;
+  }
+  return from_word(x) << common;
+}
+
+BigInteger Lcm(const BigInteger& lhs, const BigInteger& rhs) {
+  if (!lhs || !rhs) {
+    return 0;
+  }
+  return (lhs / Gcd(lhs, rhs) * rhs).Abs();
+}
+
+// Reduces a >= b >= 0 to about half the length of a, returning the matrix M of determinant +-1, and its determinant,
+// such that the input (a, b) is M times the output. The leading halves are reduced recursively twice, with a
+// division step in between, as in Moller's "On Schonhage's algorithm and subquadratic integer GCD computation"; a
+// matrix found on leading limbs may miss the last quotients of the full numbers, which ApplyInverse and the final
+// Lehmer steps absorb.
+int BigInteger::HalfGcd(BigInteger& a, BigInteger& b, BigInteger matrix[2][2]) {
+  matrix[0][0] = 1;
+  matrix[0][1] = 0;
+  matrix[1][0] = 0;
+  matrix[1][1] = 1;
+  int determinant = 1;
+  const size_t n = a.limbs_.Size();
+  const size_t target = n / 2 + 1;
+  if (n >= kGcdRecursionThreshold) {
+    BigInteger first[2][2];
+    BigInteger a_top = a >> (n / 2 * kLimbBits);
+    BigInteger b_top = b >> (n / 2 * kLimbBits);
+    determinant = HalfGcd(a_top, b_top, first);
+    ApplyInverse(a, b, first, determinant);
+    for (int i = 0; i < 2; ++i) {
+      for (int j = 0; j < 2; ++j) {
+        matrix[i][j] = std::move(first[i][j]);
+      }
+    }
+    if (b.limbs_.Size() > target) {
+      DivisionStep(a, b, matrix, determinant);
+    }
+    const size_t size = a.limbs_.Size();
+    if (b.limbs_.Size() > target && size < target + n / 2) {
+      const size_t shift = (2 * target - size) * kLimbBits;
+      BigInteger second[2][2];
+      BigInteger a_top = a >> shift;
+      BigInteger b_top = b >> shift;
+      int second_determinant = HalfGcd(a_top, b_top, second);
+      ApplyInverse(a, b, second, second_determinant);
+      BigInteger product[2][2];
+      for (int i = 0; i < 2; ++i) {
+        for (int j = 0; j < 2; ++j) {
+          product[i][j] = MulUnlimited(matrix[i][0], second[0][j]) + MulUnlimited(matrix[i][1], second[1][j]);
+        }
+      }
+      for (int i = 0; i < 2; ++i) {
+        for (int j = 0; j < 2; ++j) {
+          matrix[i][j] = std::move(product[i][j]);
+        }
+      }
+      determinant *= second_determinant;
+    }
+  }
+  while (b.limbs_.Size() > target) {
+    LehmerStep(a, b, matrix, determinant);
+  }
+  return determinant;
+}
+
+// Replaces (a, b) by M^-1 (a, b) = determinant (m11 a - m01 b, m00 b - m10 a). When M came from leading limbs the
+// values can come out negative or in the wrong order; they are then negated or swapped together with the matching
+// columns of M, which keeps (a, b) = M (alpha, beta) and the GCD unchanged.
+void BigInteger::ApplyInverse(BigInteger& a, BigInteger& b, BigInteger matrix[2][2], int& determinant) {
+  BigInteger alpha = MulUnlimited(matrix[1][1], a) - MulUnlimited(matrix[0][1], b);
+  BigInteger beta = MulUnlimited(matrix[0][0], b) - MulUnlimited(matrix[1][0], a);
+  if (determinant < 0) {
+    alpha = -alpha;
+    beta = -beta;
+  }
+  a = std::move(alpha);
+  b = std::move(beta);
+  for (int column = 0; column < 2; ++column) {
+    BigInteger& value = column == 0 ? a : b;
+    if (value.is_negative_) {
+      value.is_negative_ = false;
+      matrix[0][column] = -matrix[0][column];
+      matrix[1][column] = -matrix[1][column];
+      determinant = -determinant;
+    }
+  }
+  if (a < b) {
+    std::swap(a, b);
+    std::swap(matrix[0][0], matrix[0][1]);
+    std::swap(matrix[1][0], matrix[1][1]);
+    determinant = -determinant;
+  }
+}
+
+// One step of Lehmer's algorithm (Knuth, TAOCP 4.5.2, algorithm L) for a >= b > 0: the quotients of the leading 62
+// bits of a and b that are certain to be those of a and b are gathered in a matrix L of single words, which is then
+// applied to a and b, and its inverse to matrix unless that is null. Without a certain quotient, a division step is
+// taken instead.
+void BigInteger::LehmerStep(BigInteger& a, BigInteger& b, BigInteger (*matrix)[2], int& determinant) {
+  const size_t bits = a.BitLength();
+  const size_t shift = bits > 62 ? bits - 62 : 0;
+  auto leading = [shift](const Limbs& limbs) {
+    auto limb = [&limbs](size_t index) { return index < limbs.Size() ? DoubleLimb{limbs[index]} : 0; };
+    const size_t index = shift / kLimbBits;
+    const int bit = shift % kLimbBits;
+    uint64_t low = limb(index) | (limb(index + 1) << kLimbBits);
+    uint64_t result = low >> bit;
+    if (bit > 0) {
+      result |= limb(index + 2) << (2 * kLimbBits - bit);
+    }
+    return static_cast<int64_t>(result);
+  };
+  int64_t x = leading(a.limbs_);
+  int64_t y = leading(b.limbs_);
+  int64_t u0 = 1;
+  int64_t u1 = 0;
+  int64_t v0 = 0;
+  int64_t v1 = 1;
+  int sign = 1;
+  while (y + v0 != 0 && y + v1 != 0) {
+    int64_t q = (x + u0) / (y + v0);
+    if (q != (x + u1) / (y + v1)) {
+      break;
+    }
+    int64_t t = u0 - q * v0;
+    u0 = v0;
+    v0 = t;
+    t = u1 - q * v1;
+    u1 = v1;
+    v1 = t;
+    t = x - q * y;
+    x = y;
+    y = t;
+    sign = -sign;
+  }
+  if (u1 == 0) {
+    DivisionStep(a, b, matrix, determinant);
+    return;
+  }
+  BigInteger next_a = MulUnlimited(a, u0) + MulUnlimited(b, u1);
+  b = MulUnlimited(a, v0) + MulUnlimited(b, v1);
+  a = std::move(next_a);
+  if (matrix != nullptr) {
+    // L^-1 = det L (v1, -u1; -v0, u0), with det L = sign.
+    for (int row = 0; row < 2; ++row) {
+      BigInteger first = MulUnlimited(matrix[row][0], v1) - MulUnlimited(matrix[row][1], v0);
+      BigInteger second = MulUnlimited(matrix[row][1], u0) - MulUnlimited(matrix[row][0], u1);
+      matrix[row][0] = sign > 0 ? std::move(first) : -first;
+      matrix[row][1] = sign > 0 ? std::move(second) : -second;
+    }
+  }
+  determinant *= sign;
+}
+
+// (a, b) becomes (b, a mod b), and matrix, unless null, is multiplied by (q, 1; 1, 0).
+void BigInteger::DivisionStep(BigInteger& a, BigInteger& b, BigInteger (*matrix)[2], int& determinant) {
+  auto [quotient, remainder] = DivMod(a, b);
+  a = std::move(b);
+  b = std::move(remainder);
+  if (matrix != nullptr) {
+    for (int row = 0; row < 2; ++row) {
+      BigInteger first = MulUnlimited(matrix[row][0], quotient) + matrix[row][1];
+      matrix[row][1] = std::move(matrix[row][0]);
+      matrix[row][0] = std::move(first);
+    }
+  }
+  determinant = -determinant;
+}
+
+// A single thread multiplies the whole tree. With multiplication threads, the values are cut into four runs of about
+// equal total length per thread, whose products are computed on the pool, and the products of the runs are
+// multiplied on this thread, where MulAbs shares the long multiplications of the top of the tree.
+BigInteger Product(const std::vector<BigInteger>& values) {
+  BigInteger result(1);
+  for (const BigInteger& value : values) {
+    if (!value) {
+      return 0;
+    }
+    result.is_negative_ = result.is_negative_ != value.is_negative_;
+  }
+  const bool negative = result.is_negative_;
+  if (values.empty()) {
+    return result;
+  }
+  if (!BigInteger::multiplication_pool_ || ThreadPool::InWorker()) {
+    result.limbs_ = BigInteger::ProductTree(values.data(), values.size());
+  } else {
+    size_t total = 0;
+    for (const BigInteger& value : values) {
+      total += value.limbs_.Size();
+    }
+    const size_t runs = 4 * BigInteger::multiplication_pool_->Size();
+    // The runs read values, so all of them finish before this goes on or throws.
+    std::vector<std::future<BigInteger>> products;
+    products.reserve(runs + 1);
+    size_t begin = 0;
+    size_t length = 0;
+    try {
+      for (size_t i = 0; i < values.size(); ++i) {
+        length += values[i].limbs_.Size();
+        if (length * runs >= total * (products.size() + 1) || i + 1 == values.size()) {
+          products.push_back(BigInteger::multiplication_pool_->Submit([&values, begin, i] {
+            BigInteger product;
+            product.limbs_ = BigInteger::ProductTree(values.data() + begin, i + 1 - begin);
+            return product;
+          }));
+          begin = i + 1;
+        }
+      }
+    } catch (...) {
+      WaitForAll(products);
+      throw;
+    }
+    WaitForAll(products);
+    std::vector<BigInteger> partial;
+    for (auto& product : products) {
+      partial.push_back(product.get());
+    }
+    result.limbs_ = BigInteger::ProductTree(partial.data(), partial.size());
+  }
+  result.is_negative_ = negative;
+  if (result.ExceedsDigitLimit()) {
+    throw BigIntegerOverflow();
+  }
+  return result;
+}
+
+// Product of the magnitudes of count > 0 nonzero values, split where the running length passes half of the total.
+BigInteger::Limbs BigInteger::ProductTree(const BigInteger* values, size_t count) {
+  if (count == 1) {
+    return values[0].limbs_;
+  }
+  if (count == 2) {
+    return MulAbs(values[0].limbs_, values[1].limbs_);
+  }
+  size_t total = 0;
+  for (size_t i = 0; i < count; ++i) {
+    total += values[i].limbs_.Size();
+  }
+  size_t middle = 1;
+  for (size_t length = values[0].limbs_.Size(); middle + 1 < count && 2 * length < total; ++middle) {
+    length += values[middle].limbs_.Size();
+  }
+  return MulAbs(ProductTree(values, middle), ProductTree(values + middle, count - middle));
+}
+
+BigIntegerView::BigIntegerView() : limbs_(nullptr), size_(0), is_negative_(false) {
+}
+
+BigIntegerView::BigIntegerView(const BigInteger& value)
+    : limbs_(value.limbs_.Data()), size_(value.limbs_.Size()), is_negative_(value.is_negative_) {
+}
+
+BigIntegerView::BigIntegerView(const BigInteger::Limb* limbs, size_t size, bool is_negative)
+    : limbs_(limbs), size_(size), is_negative_(is_negative) {
+}
+
+const std::byte* BigIntegerView::Deserialize(const std::byte* first, const std::byte* last, BigIntegerView& view) {
+  const uint32_t one = 1;
+  if (*reinterpret_cast<const unsigned char*>(&one) != 1) {
+    throw BigIntegerFormatError("BigIntegerView needs a little-endian host");
+  }
+  if (reinterpret_cast<uintptr_t>(first) % alignof(BigInteger::Limb) != 0) {
+    throw BigIntegerFormatError("Misaligned BigInteger record");
+  }
+  size_t size;
+  bool negative;
+  first = BigInteger::ReadSerializedHeader(first, last, size, negative);
+  view = BigIntegerView(reinterpret_cast<const BigInteger::Limb*>(first), size, negative);
+  return first + size * sizeof(BigInteger::Limb);
+}
+
+bool BigIntegerView::IsNegative() const {
+  return is_negative_;
+}
+
+BigIntegerView::operator bool() const {
+  return size_ != 0;
+}
+
+int BigIntegerView::Compare(BigIntegerView lhs, BigIntegerView rhs) {
+  if (lhs.is_negative_ != rhs.is_negative_) {
+    return lhs.is_negative_ ? -1 : 1;
+  }
+  int order = BigInteger::CompareAbs(lhs.limbs_, lhs.size_, rhs.limbs_, rhs.size_);
+  return lhs.is_negative_ ? -order : order;
+}
+
+bool operator==(BigIntegerView lhs, BigIntegerView rhs) {
+  return BigIntegerView::Compare(lhs, rhs) == 0;
+}
+
+bool operator!=(BigIntegerView lhs, BigIntegerView rhs) {
+  return BigIntegerView::Compare(lhs, rhs) != 0;
+}
+
+bool operator<(BigIntegerView lhs, BigIntegerView rhs) {
+  return BigIntegerView::Compare(lhs, rhs) < 0;
+}
+
+bool operator<=(BigIntegerView lhs, BigIntegerView rhs) {
+  return BigIntegerView::Compare(lhs, rhs) <= 0;
+}
+
+bool operator>(BigIntegerView lhs, BigIntegerView rhs) {
+  return BigIntegerView::Compare(lhs, rhs) > 0;
+}
+
+bool operator>=(BigIntegerView lhs, BigIntegerView rhs) {
+  return BigIntegerView::Compare(lhs, rhs) >= 0;
+}
+
+BigInteger operator+(BigIntegerView lhs, BigIntegerView rhs) {
+  BigInteger result(lhs);
+  return result += rhs;
+}
+
+BigInteger operator-(BigIntegerView lhs, BigIntegerView rhs) {
+  BigInteger result(lhs);
+  return result -= rhs;
+}
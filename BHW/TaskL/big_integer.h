@@ -8,7 +8,18 @@
 #include <algorithm>
 #include <stdexcept>
 #include <cmath>
+#include <cstddef>
 #include <cstdint>
+#include <deque>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+#include "limb_vector.h"
+#include "thread_pool.h"
+
+#define BIG_INTEGER_DIVISION_IMPLEMENTED
 
 class BigIntegerOverflow : public std::runtime_error {
  public:
@@ -22,20 +33,78 @@ class BigIntegerDivisionByZero : public std::runtime_error {
   }
 };
 
+class BigIntegerDomainError : public std::domain_error {
+ public:
+  explicit BigIntegerDomainError(const std::string& what) : std::domain_error(what) {
+  }
+};
+
+class BigIntegerFormatError : public std::invalid_argument {
+ public:
+  explicit BigIntegerFormatError(const std::string& what) : std::invalid_argument(what) {
+  }
+};
+
+class BigIntegerView;
+
 class BigInteger {
  private:
-  std::vector<int> digits_;
+  using Limb = uint32_t;
+  using DoubleLimb = uint64_t;
+  using Limbs = LimbVector;
+
+  // Magnitude in base 2^32, least significant limb first, without leading zero limbs. Zero has no limbs.
+  Limbs limbs_;
   bool is_negative_;
 
-  static const int kBASE = 10000;
-  static const int kBaseDigits = 4;
+  static const int kLimbBits = 32;
+  static const Limb kDecimalChunk = 1000000000;
+  static const int kDecimalChunkDigits = 9;
+  // Longest product, in limbs, that one number-theoretic transform handles; 2^23 is the largest power of two
+  // dividing 998244353 - 1.
+  static const size_t kNttMaxLength = size_t{1} << 23;
+  // Divisor and quotient lengths, in limbs, below which division runs Knuth's algorithm D directly rather than
+  // recursing Burnikel-Ziegler style.
+  static const size_t kDivisionRecursionThreshold = 48;
+  // Length, in nine-digit chunks or limbs, below which decimal conversion works chunk by chunk rather than by
+  // divide and conquer.
+  static const size_t kDecimalRecursionChunks = 32;
+  // Length, in limbs, from which the GCD reduces the leading halves of its operands recursively rather than by
+  // Lehmer steps.
+  static const size_t kGcdRecursionThreshold = 128;
+  // Length, in limbs, of the shorter operand from which a multiplication is shared between threads.
+  static const size_t kParallelMultiplicationThreshold = 1024;
 
  public:
+  // Operand lengths, in 32-bit limbs, from which multiplication switches from schoolbook to Karatsuba, from
+  // Karatsuba to Toom-3 and from Toom-3 to the number-theoretic transform. big_integer_benchmark.cpp measures good
+  // values for the host.
+  struct MultiplicationThresholds {
+    size_t karatsuba;
+    size_t toom3;
+    size_t ntt;
+  };
+
+  static MultiplicationThresholds GetMultiplicationThresholds();
+  static void SetMultiplicationThresholds(MultiplicationThresholds thresholds);
+
+  // Products with more decimal digits than this throw BigIntegerOverflow. kDefaultMaxDigits unless changed;
+  // std::numeric_limits<size_t>::max() disables the check.
+  static const size_t kDefaultMaxDigits = 30009;
+  static size_t GetMaxDigits();
+  static void SetMaxDigits(size_t digits);
+
+  // Threads that share long multiplications and the subtrees of Product. 1, the default, keeps all work on the
+  // calling thread. Not to be changed while another thread multiplies.
+  static size_t GetMultiplicationThreads();
+  static void SetMultiplicationThreads(size_t threads);
+
   BigInteger();
   BigInteger(int value);      // NOLINT
   BigInteger(int64_t value);  // NOLINT
   explicit BigInteger(const char* value);
   explicit BigInteger(const std::string& value);
+  explicit BigInteger(BigIntegerView value);
 
   BigInteger(const BigInteger& other) = default;
   BigInteger(BigInteger&& other) noexcept;
@@ -49,6 +118,30 @@ class BigInteger {
   BigInteger& operator+=(const BigInteger& other);
   BigInteger& operator-=(const BigInteger& other);
   BigInteger& operator*=(const BigInteger& other);
+  // Small operands are used as one or two limbs on the stack, without a temporary BigInteger.
+  BigInteger& operator+=(int64_t other);
+  BigInteger& operator-=(int64_t other);
+  BigInteger& operator*=(int64_t other);
+  // Adds the limbs of the view straight from its memory.
+  BigInteger& operator+=(BigIntegerView other);
+  BigInteger& operator-=(BigIntegerView other);
+  BigInteger& operator/=(const BigInteger& other);
+  BigInteger& operator%=(const BigInteger& other);
+
+  // Bitwise operators act on the infinite two's complement of both operands, as for built-in signed integers: ~x is
+  // -x - 1 and x & y is negative only when both are. Shifts are by a bit count; >> rounds toward negative infinity,
+  // as an arithmetic shift does.
+  BigInteger operator~() const;
+  BigInteger& operator&=(const BigInteger& other);
+  BigInteger& operator|=(const BigInteger& other);
+  BigInteger& operator^=(const BigInteger& other);
+  BigInteger& operator<<=(size_t shift);
+  BigInteger& operator>>=(size_t shift);
+
+  // *this += lhs * rhs and *this -= lhs * rhs. A product with a short factor is accumulated in place, without
+  // materializing it, when it adds to the magnitude of *this.
+  BigInteger& AddMul(const BigInteger& lhs, const BigInteger& rhs);
+  BigInteger& SubMul(const BigInteger& lhs, const BigInteger& rhs);
 
   BigInteger& operator=(int value);
   BigInteger& operator=(const BigInteger& other);
@@ -57,7 +150,35 @@ class BigInteger {
   friend BigInteger operator+(BigInteger lhs, const BigInteger& rhs);
   friend BigInteger operator-(BigInteger lhs, const BigInteger& rhs);
   friend BigInteger operator*(BigInteger lhs, const BigInteger& rhs);
+  friend BigInteger operator+(BigInteger lhs, int64_t rhs);
+  friend BigInteger operator-(BigInteger lhs, int64_t rhs);
+  friend BigInteger operator*(BigInteger lhs, int64_t rhs);
+  friend BigInteger operator/(BigInteger lhs, const BigInteger& rhs);
+  friend BigInteger operator%(BigInteger lhs, const BigInteger& rhs);
+  friend BigInteger operator&(BigInteger lhs, const BigInteger& rhs);
+  friend BigInteger operator|(BigInteger lhs, const BigInteger& rhs);
+  friend BigInteger operator^(BigInteger lhs, const BigInteger& rhs);
+  friend BigInteger operator<<(BigInteger lhs, size_t shift);
+  friend BigInteger operator>>(BigInteger lhs, size_t shift);
+
+  // Quotient rounded toward zero and remainder with the sign of lhs, as for built-in integers.
+  friend std::pair<BigInteger, BigInteger> DivMod(const BigInteger& lhs, const BigInteger& rhs);
 
+  // base^exponent mod |modulus|, in [0, |modulus|), for a non-negative exponent. Odd moduli go through
+  // MontgomeryContext, even ones through sliding-window powering with long division.
+  friend BigInteger PowMod(const BigInteger& base, const BigInteger& exponent, const BigInteger& modulus);
+
+  // Non-negative greatest common divisor and least common multiple; Gcd(0, 0) and Lcm(x, 0) are 0.
+  friend BigInteger Gcd(const BigInteger& lhs, const BigInteger& rhs);
+  friend BigInteger Lcm(const BigInteger& lhs, const BigInteger& rhs);
+  // floor(sqrt(value)) for a non-negative value.
+  friend BigInteger ISqrt(const BigInteger& value);
+  // base^exponent, with 0^0 = 1.
+  friend BigInteger Pow(const BigInteger& base, uint64_t exponent);
+
+  // Product of all values, 1 for none, by a product tree balanced on the lengths of the values, so that the long
+  // multiplications come last and fast algorithms apply to them.
+  friend BigInteger Product(const std::vector<BigInteger>& values);
 
   BigInteger& operator++();
   BigInteger operator++(int);
@@ -66,6 +187,18 @@ class BigInteger {
 
   explicit operator bool() const;
 
+  // Bits of |x| and set bits of |x|, as Python's int.bit_length() and int.bit_count(); TestBit reads bit index of the
+  // two's complement, so that TestBit(i) == ((x >> i) & 1) != 0.
+  size_t BitLength() const;
+  size_t PopCount() const;
+  bool TestBit(size_t index) const;
+
+  // Decimal representation, as printed by operator<<. ToChars writes it to first, without a terminating null, and
+  // returns the end of the output; it never writes more than MaxCharsLength() characters.
+  std::string ToString() const;
+  char* ToChars(char* first) const;
+  size_t MaxCharsLength() const;
+
   friend bool operator==(const BigInteger& lhs, const BigInteger& rhs);
   friend bool operator!=(const BigInteger& lhs, const BigInteger& rhs);
   friend bool operator<(const BigInteger& lhs, const BigInteger& rhs);
@@ -76,8 +209,151 @@ class BigInteger {
   friend std::ostream& operator<<(std::ostream& os, const BigInteger& value);
   friend std::istream& operator>>(std::istream& is, BigInteger& value);
 
+  // Binary form: a little-endian 32-bit header holding twice the number of limbs, plus one for a negative value, then
+  // the limbs of the magnitude as little-endian 32-bit words, least significant first, without leading zero limbs.
+  // A record thus keeps the alignment of its first byte to 4 bytes, which BigIntegerView relies on. Serialize writes
+  // SerializedSize() bytes to first and returns the end of the output. Deserialize reads one record from
+  // [first, last) into value and returns its end; a truncated or non-canonical record throws BigIntegerFormatError.
+  size_t SerializedSize() const;
+  std::byte* Serialize(std::byte* first) const;
+  static const std::byte* Deserialize(const std::byte* first, const std::byte* last, BigInteger& value);
+
  private:
+  friend class MontgomeryContext;
+  friend class BigIntegerView;
+
+  static const size_t kSerializedHeaderBytes = 4;
+
   void Trim();
   void FromString(const std::string& value);
-  size_t DigitCount() const;
-};
\ No newline at end of file
+  bool ExceedsDigitLimit() const;
+
+  BigInteger& AddSigned(const Limb* other, size_t other_size, bool other_negative);
+  BigInteger& AddMulSigned(const BigInteger& lhs, const BigInteger& rhs, bool negative);
+  template <class Operation>
+  BigInteger& BitwiseAssign(const BigInteger& other, Operation operation);
+  Limb DivModSmall(Limb divisor);
+
+  static void TrimLimbs(Limbs& limbs);
+  static Limbs Slice(const Limbs& limbs, size_t begin, size_t end);
+  static size_t SplitMagnitude(int64_t value, Limb parts[2]);
+  static int CompareAbs(const Limb* lhs, size_t lhs_size, const Limb* rhs, size_t rhs_size);
+  static int CompareAbs(const Limbs& lhs, const Limbs& rhs);
+  static void AddAbs(Limbs& lhs, const Limbs& rhs);
+  static void AddAbsShifted(Limbs& lhs, const Limb* rhs, size_t rhs_size, size_t shift);
+  static void AddAbsShifted(Limbs& lhs, const Limbs& rhs, size_t shift);
+  static void SubAbs(Limbs& lhs, const Limb* rhs, size_t rhs_size);
+  static void SubAbs(Limbs& lhs, const Limbs& rhs);
+  static void SubAbsFrom(Limbs& lhs, const Limb* rhs, size_t rhs_size);
+  static void AddMulLimb(Limbs& lhs, const Limbs& rhs, Limb multiplier, size_t shift);
+  static Limbs MulAbs(const Limbs& lhs, const Limbs& rhs);
+  static Limbs MulSchoolbook(const Limbs& lhs, const Limbs& rhs);
+  static Limbs MulUnbalanced(const Limbs& lhs, const Limbs& rhs);
+  static Limbs MulKaratsuba(const Limbs& lhs, const Limbs& rhs);
+  static Limbs MulToom3(const Limbs& lhs, const Limbs& rhs);
+  static Limbs MulNtt(const Limbs& lhs, const Limbs& rhs);
+  static Limbs MulParallel(const Limbs& lhs, const Limbs& rhs);
+  static Limbs ProductTree(const BigInteger* values, size_t count);
+  static Limbs SqrAbs(const Limbs& value);
+  static Limbs SqrSchoolbook(const Limbs& value);
+  static Limbs SqrKaratsuba(const Limbs& value);
+  template <class Multiply, class Square>
+  static Limbs PowerSlidingWindow(const Limbs& base, const Limbs& exponent, Multiply multiply, Square square);
+  static Limbs Residue(const BigInteger& value, const Limbs& modulus);
+  static BigInteger MulUnlimited(const BigInteger& lhs, const BigInteger& rhs);
+  static int HalfGcd(BigInteger& a, BigInteger& b, BigInteger matrix[2][2]);
+  static void ApplyInverse(BigInteger& a, BigInteger& b, BigInteger matrix[2][2], int& determinant);
+  static void LehmerStep(BigInteger& a, BigInteger& b, BigInteger (*matrix)[2], int& determinant);
+  static void DivisionStep(BigInteger& a, BigInteger& b, BigInteger (*matrix)[2], int& determinant);
+  static Limbs PowerOfTen(size_t exponent);
+  static const std::byte* ReadSerializedHeader(const std::byte* first, const std::byte* last, size_t& size,
+                                               bool& negative);
+  static void MulAddLimb(Limbs& limbs, Limb multiplier, Limb addend);
+  static Limb DivModLimb(Limbs& limbs, Limb divisor);
+  static void ShiftLeftBits(Limbs& limbs, int bits);
+  static void ShiftRightBits(Limbs& limbs, int bits);
+  static void DivModAbs(const Limbs& lhs, const Limbs& rhs, Limbs& quotient, Limbs& remainder);
+  static void DivModKnuth(const Limbs& lhs, const Limbs& rhs, Limbs& quotient, Limbs& remainder);
+  static void DivModRecursive(const Limbs& lhs, const Limbs& rhs, Limbs& quotient, Limbs& remainder);
+  static const Limbs& DecimalPower(size_t level);
+  static Limbs ParseDecimal(const char* digits, size_t count);
+  static char* WriteDecimal(const Limbs& value, size_t level, bool pad, char* out);
+
+  static MultiplicationThresholds multiplication_thresholds_;
+  static size_t max_digits_;
+  static std::unique_ptr<ThreadPool> multiplication_pool_;
+};
+
+// Declared outside the class too, so that a braced list of values finds it.
+BigInteger Product(const std::vector<BigInteger>& values);
+
+// Read-only integer over limbs owned elsewhere, such as a record of BigInteger::Serialize in a mapped file, that is
+// compared and added without copying the limbs into a BigInteger. The memory must outlive the view.
+class BigIntegerView {
+ public:
+  BigIntegerView();
+  BigIntegerView(const BigInteger& value);  // NOLINT
+
+  // Views one record of the binary form in place and returns its end. Besides the checks of
+  // BigInteger::Deserialize, the record must start at an address aligned to 4 bytes and the host must be
+  // little-endian, so that the limbs can be read where they are.
+  static const std::byte* Deserialize(const std::byte* first, const std::byte* last, BigIntegerView& view);
+
+  bool IsNegative() const;
+  explicit operator bool() const;
+
+  friend bool operator==(BigIntegerView lhs, BigIntegerView rhs);
+  friend bool operator!=(BigIntegerView lhs, BigIntegerView rhs);
+  friend bool operator<(BigIntegerView lhs, BigIntegerView rhs);
+  friend bool operator<=(BigIntegerView lhs, BigIntegerView rhs);
+  friend bool operator>(BigIntegerView lhs, BigIntegerView rhs);
+  friend bool operator>=(BigIntegerView lhs, BigIntegerView rhs);
+
+  friend BigInteger operator+(BigIntegerView lhs, BigIntegerView rhs);
+  friend BigInteger operator-(BigIntegerView lhs, BigIntegerView rhs);
+
+ private:
+  friend class BigInteger;
+
+  const BigInteger::Limb* limbs_;
+  size_t size_;
+  bool is_negative_;
+
+  BigIntegerView(const BigInteger::Limb* limbs, size_t size, bool is_negative);
+
+  // Sign of lhs - rhs.
+  static int Compare(BigIntegerView lhs, BigIntegerView rhs);
+};
+
+// Arithmetic modulo a fixed odd modulus m of n limbs in Montgomery form: a residue x is kept as x R mod m with
+// R = 2^(32 n), so that a product costs a multiplication and a reduction by R rather than a long division. The
+// reduction constants are computed once, by the constructor.
+class MontgomeryContext {
+ public:
+  explicit MontgomeryContext(const BigInteger& modulus);
+
+  const BigInteger& Modulus() const;
+
+  // value mod m to Montgomery form and back; FromMontgomery expects a value in [0, m).
+  BigInteger ToMontgomery(const BigInteger& value) const;
+  BigInteger FromMontgomery(const BigInteger& value) const;
+
+  // Montgomery products of values in [0, m), in Montgomery form. Square uses the dedicated squaring kernel.
+  BigInteger Multiply(const BigInteger& lhs, const BigInteger& rhs) const;
+  BigInteger Square(const BigInteger& value) const;
+
+  // base^exponent mod m, in [0, m), by sliding-window powering in Montgomery form.
+  BigInteger PowMod(const BigInteger& base, const BigInteger& exponent) const;
+
+ private:
+  using Limb = BigInteger::Limb;
+  using DoubleLimb = BigInteger::DoubleLimb;
+  using Limbs = BigInteger::Limbs;
+
+  BigInteger modulus_;
+  // R^2 mod m, which takes values to Montgomery form in one reduction, and -1 / m mod 2^32.
+  Limbs r_squared_;
+  Limb inverse_;
+
+  void Reduce(Limbs& value) const;
+};
@@ -0,0 +1,603 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <limits>
+#include <new>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "big_integer.h"
+
+// Build: g++ -std=c++17 -O2 -pthread big_integer.cpp big_integer_benchmark.cpp -o big_integer_benchmark
+
+static size_t heap_allocations = 0;
+static volatile size_t sink = 0;
+
+void* operator new(size_t size) {
+  ++heap_allocations;
+  if (void* p = std::malloc(size == 0 ? 1 : size)) {
+    return p;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+  std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+  std::free(p);
+}
+
+// The base-10000 kernels BigInteger used before the switch to binary limbs, kept for comparison.
+const int kLegacyBase = 10000;
+
+void LegacyAdd(std::vector<int>& lhs, const std::vector<int>& rhs) {
+  int carry = 0;
+  for (size_t i = 0; i < std::max(lhs.size(), rhs.size()) || carry; ++i) {
+    if (i == lhs.size()) {
+      lhs.push_back(0);
+    }
+    lhs[i] += carry + (i < rhs.size() ? rhs[i] : 0);
+    carry = lhs[i] >= kLegacyBase;
+    if (carry) {
+      lhs[i] -= kLegacyBase;
+    }
+  }
+}
+
+void LegacySub(std::vector<int>& lhs, const std::vector<int>& rhs) {
+  int carry = 0;
+  for (size_t i = 0; i < rhs.size() || carry; ++i) {
+    lhs[i] -= carry + (i < rhs.size() ? rhs[i] : 0);
+    carry = lhs[i] < 0;
+    if (carry) {
+      lhs[i] += kLegacyBase;
+    }
+  }
+  while (!lhs.empty() && lhs.back() == 0) {
+    lhs.pop_back();
+  }
+}
+
+std::vector<int> LegacyMul(const std::vector<int>& lhs, const std::vector<int>& rhs) {
+  std::vector<uint64_t> result(lhs.size() + rhs.size(), 0);
+  for (size_t i = 0; i < lhs.size(); ++i) {
+    for (size_t j = 0; j < rhs.size(); ++j) {
+      result[i + j] += static_cast<uint64_t>(lhs[i]) * rhs[j];
+      if (result[i + j] >= kLegacyBase) {
+        result[i + j + 1] += result[i + j] / kLegacyBase;
+        result[i + j] %= kLegacyBase;
+      }
+    }
+  }
+  return std::vector<int>(result.begin(), result.end());
+}
+
+std::vector<int> LegacyFromString(const std::string& value) {
+  std::vector<int> digits;
+  for (int i = static_cast<int>(value.size()) - 1; i >= 0; i -= 4) {
+    digits.push_back(std::stoi(value.substr(std::max(0, i - 3), i - std::max(0, i - 3) + 1)));
+  }
+  return digits;
+}
+
+std::string RandomDigits(size_t count, std::mt19937& rng) {
+  std::uniform_int_distribution<int> digit(0, 9);
+  std::string s(count, '0');
+  for (char& c : s) {
+    c = static_cast<char>('0' + digit(rng));
+  }
+  s[0] = '9';
+  return s;
+}
+
+template <typename F>
+double NanosecondsPerRun(size_t runs, F f) {
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < runs; ++i) {
+    f();
+  }
+  std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+  return elapsed.count() / static_cast<double>(runs);
+}
+
+void Row(const char* operation, size_t digits, double legacy_ns, double binary_ns) {
+  std::printf("%-4s %9zu %14.0f %14.0f %8.2fx\n", operation, digits, legacy_ns, binary_ns, legacy_ns / binary_ns);
+}
+
+// Times add, subtract and multiply of two random numbers with the given number of decimal digits. Multiplication
+// is skipped at sizes where the quadratic legacy kernel would run for minutes or the result exceeds the digit cap.
+void Compare(size_t digits, std::mt19937& rng) {
+  const std::string a = RandomDigits(digits, rng);
+  const std::string b = RandomDigits(digits, rng);
+  const std::vector<int> legacy_a = LegacyFromString(a);
+  const std::vector<int> legacy_b = LegacyFromString(b);
+  const BigInteger binary_a(a);
+  const BigInteger binary_b(b);
+  const size_t linear_runs = std::max<size_t>(1, 100'000'000 / digits);
+
+  std::vector<int> legacy_sum = legacy_a;
+  double legacy_add = NanosecondsPerRun(linear_runs, [&] { LegacyAdd(legacy_sum, legacy_b); });
+  BigInteger binary_sum = binary_a;
+  double binary_add = NanosecondsPerRun(linear_runs, [&] { binary_sum += binary_b; });
+  Row("add", digits, legacy_add, binary_add);
+
+  double legacy_sub = NanosecondsPerRun(linear_runs, [&] { LegacySub(legacy_sum, legacy_b); });
+  double binary_sub = NanosecondsPerRun(linear_runs, [&] { binary_sum -= binary_b; });
+  sink = legacy_sum.size() + static_cast<size_t>(binary_sum == binary_a);
+  Row("sub", digits, legacy_sub, binary_sub);
+
+  if (digits <= 10'000) {
+    const size_t runs = std::max<size_t>(1, 10'000'000'000 / (digits * digits));
+    double legacy_mul = NanosecondsPerRun(runs, [&] { sink = LegacyMul(legacy_a, legacy_b).size(); });
+    double binary_mul = NanosecondsPerRun(runs, [&] { sink = static_cast<bool>(binary_a * binary_b); });
+    Row("mul", digits, legacy_mul, binary_mul);
+  }
+}
+
+// Values that mostly fit in 64 bits: construction from int64_t, copies, add, subtract, multiply by a small factor and
+// compare, with a 128-bit product folded into a running total every 16th step.
+void MixedSmallWorkload(std::mt19937& rng) {
+  const size_t count = 1'000'000;
+  std::uniform_int_distribution<int64_t> distribution(-(int64_t{1} << 40), int64_t{1} << 40);
+  std::vector<int64_t> inputs(count);
+  for (int64_t& input : inputs) {
+    input = distribution(rng);
+  }
+  BigInteger total;
+  size_t smaller = 0;
+  heap_allocations = 0;
+  double ns = NanosecondsPerRun(1, [&] {
+    for (size_t i = 0; i + 1 < count; ++i) {
+      BigInteger a(inputs[i]);
+      BigInteger b(inputs[i + 1]);
+      BigInteger c = a + b;
+      c -= a * 3;
+      smaller += c < a;
+      if (i % 16 == 0) {
+        total += a * b;
+      }
+    }
+  });
+  size_t allocations = heap_allocations;
+  sink = smaller + static_cast<size_t>(static_cast<bool>(total));
+  std::printf("\nmixed 64-bit workload: %.3f heap allocations and %.1f ns per step\n",
+              static_cast<double>(allocations) / (count - 1), ns / (count - 1));
+}
+
+// 10^7 increments through a temporary BigInteger(1), as operator++ used to do, against operator++ itself; then a dot
+// product of 100-digit numbers with small factors accumulated as acc += a * b and with AddMul.
+void SmallOperandLoops(std::mt19937& rng) {
+  const size_t increments = 10'000'000;
+  std::printf("\nms per loop\n%-22s %14s %14s %9s\n", "loop", "before", "after", "speedup");
+  BigInteger before("1" + std::string(30, '0'));
+  BigInteger after = before;
+  double temporary_ms = NanosecondsPerRun(1, [&] {
+    for (size_t i = 0; i < increments; ++i) {
+      before += BigInteger(1);
+    }
+  }) / 1e6;
+  double increment_ms = NanosecondsPerRun(1, [&] {
+    for (size_t i = 0; i < increments; ++i) {
+      ++after;
+    }
+  }) / 1e6;
+  sink = static_cast<size_t>(before == after);
+  std::printf("%-22s %14.1f %14.1f %8.2fx\n", "10^7 x ++", temporary_ms, increment_ms, temporary_ms / increment_ms);
+
+  std::vector<BigInteger> a;
+  std::vector<BigInteger> b;
+  for (int i = 0; i < 1000; ++i) {
+    a.emplace_back(RandomDigits(100, rng));
+    b.emplace_back(static_cast<int>(rng() >> 1));
+  }
+  BigInteger product_sum;
+  BigInteger fused_sum;
+  double product_ms = NanosecondsPerRun(1000, [&] {
+    for (size_t i = 0; i < a.size(); ++i) {
+      product_sum += a[i] * b[i];
+    }
+  }) / 1e6;
+  double fused_ms = NanosecondsPerRun(1000, [&] {
+    for (size_t i = 0; i < a.size(); ++i) {
+      fused_sum.AddMul(a[i], b[i]);
+    }
+  }) / 1e6;
+  sink = static_cast<size_t>(product_sum == fused_sum);
+  std::printf("%-22s %14.3f %14.3f %8.2fx\n", "1000-term dot product", product_ms, fused_ms, product_ms / fused_ms);
+}
+
+// Chunk-by-chunk decimal conversion, as BigInteger did it before divide and conquer: quadratic in the length.
+std::string ChunkedToString(const BigInteger& value) {
+  std::vector<std::string> chunks;
+  BigInteger rest = value.Abs();
+  while (rest) {
+    auto [quotient, remainder] = DivMod(rest, BigInteger(1'000'000'000));
+    chunks.push_back(remainder.ToString());
+    rest = std::move(quotient);
+  }
+  std::string text = value.IsNegative() ? "-" : "";
+  text += chunks.empty() ? "0" : chunks.back();
+  for (size_t i = chunks.size() - 1; i-- > 0;) {
+    text.append(9 - chunks[i].size(), '0');
+    text += chunks[i];
+  }
+  return text;
+}
+
+BigInteger ChunkedFromString(const std::string& digits) {
+  BigInteger value;
+  size_t chunk_size = digits.size() % 9 == 0 ? 9 : digits.size() % 9;
+  for (size_t pos = 0; pos < digits.size(); pos += chunk_size, chunk_size = 9) {
+    value = value * BigInteger(1'000'000'000) + BigInteger(std::stoi(digits.substr(pos, chunk_size)));
+  }
+  return value;
+}
+
+// Parsing and printing of random numbers, chunk by chunk against divide and conquer.
+void DecimalConversion(std::mt19937& rng) {
+  BigInteger::SetMaxDigits(std::numeric_limits<size_t>::max());
+  std::printf("\nms per conversion\n%-5s %9s %14s %14s %9s\n", "op", "digits", "chunked", "recursive", "speedup");
+  for (size_t digits : {10'000, 100'000, 1'000'000}) {
+    const std::string text = RandomDigits(digits, rng);
+    const size_t runs = std::max<size_t>(1, 1'000'000 / digits);
+    double chunked_parse = NanosecondsPerRun(runs, [&] { sink = static_cast<bool>(ChunkedFromString(text)); });
+    double parse = NanosecondsPerRun(runs, [&] { sink = static_cast<bool>(BigInteger(text)); });
+    std::printf("%-5s %9zu %14.2f %14.2f %8.2fx\n", "parse", digits, chunked_parse / 1e6, parse / 1e6,
+                chunked_parse / parse);
+    const BigInteger value(text);
+    double chunked_print = NanosecondsPerRun(runs, [&] { sink = ChunkedToString(value).size(); });
+    double print = NanosecondsPerRun(runs, [&] { sink = value.ToString().size(); });
+    std::printf("%-5s %9zu %14.2f %14.2f %8.2fx\n", "print", digits, chunked_print / 1e6, print / 1e6,
+                chunked_print / print);
+  }
+  BigInteger::SetMaxDigits(BigInteger::kDefaultMaxDigits);
+}
+
+// Reads kDiskValues values of one to four limbs, written to a file as decimal text and in the binary form, back from
+// the page cache: as text through operator>>, as BigIntegers through Deserialize and as views into the read buffer.
+// Each load sums the values, so that all of them are touched.
+void LoadFromDisk(std::mt19937& rng) {
+  const size_t kDiskValues = 10'000'000;
+  const char* text_path = "big_integer_benchmark.txt";
+  const char* binary_path = "big_integer_benchmark.bin";
+  std::uniform_int_distribution<int> limbs(1, 4);
+  std::vector<BigInteger> values(kDiskValues);
+  BigInteger expected_sum;
+  for (BigInteger& value : values) {
+    for (int i = limbs(rng); i > 0; --i) {
+      value <<= 32;
+      value += static_cast<int64_t>(rng() | 1);
+    }
+    value = rng() % 2 ? -value : value;
+    expected_sum += value;
+  }
+  {
+    std::ofstream text(text_path);
+    std::vector<std::byte> bytes;
+    for (const BigInteger& value : values) {
+      text << value << '\n';
+      size_t offset = bytes.size();
+      bytes.resize(offset + value.SerializedSize());
+      value.Serialize(bytes.data() + offset);
+    }
+    std::ofstream(binary_path, std::ios::binary).write(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+  }
+  values = std::vector<BigInteger>();
+
+  auto read_file = [](const char* path) {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    std::vector<std::byte> bytes(static_cast<size_t>(file.tellg()));
+    file.seekg(0).read(reinterpret_cast<char*>(bytes.data()), bytes.size());
+    return bytes;
+  };
+  std::printf("\nloading %zu values from disk\n%-22s %10s %10s %12s %12s\n", kDiskValues, "format", "MB", "ms",
+              "ns/value", "allocs/value");
+  auto row = [&](const char* format, const char* path, auto load) {
+    size_t allocations = heap_allocations;
+    BigInteger sum;
+    double ms = NanosecondsPerRun(1, [&] { sum = load(); }) / 1e6;
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    std::printf("%-22s %10.1f %10.0f %12.1f %12.2f%s\n", format, static_cast<double>(file.tellg()) / 1e6, ms,
+                ms * 1e6 / kDiskValues, static_cast<double>(heap_allocations - allocations) / kDiskValues,
+                sum == expected_sum ? "" : "  wrong sum");
+  };
+  row("text, operator>>", text_path, [&] {
+    std::ifstream text(text_path);
+    std::vector<BigInteger> loaded(kDiskValues);
+    BigInteger sum;
+    for (BigInteger& value : loaded) {
+      text >> value;
+      sum += value;
+    }
+    return sum;
+  });
+  row("binary, Deserialize", binary_path, [&] {
+    const std::vector<std::byte> bytes = read_file(binary_path);
+    std::vector<BigInteger> loaded(kDiskValues);
+    const std::byte* in = bytes.data();
+    BigInteger sum;
+    for (BigInteger& value : loaded) {
+      in = BigInteger::Deserialize(in, bytes.data() + bytes.size(), value);
+      sum += value;
+    }
+    return sum;
+  });
+  row("binary, BigIntegerView", binary_path, [&] {
+    const std::vector<std::byte> bytes = read_file(binary_path);
+    std::vector<BigIntegerView> loaded(kDiskValues);
+    const std::byte* in = bytes.data();
+    BigInteger sum;
+    for (BigIntegerView& value : loaded) {
+      in = BigIntegerView::Deserialize(in, bytes.data() + bytes.size(), value);
+      sum += value;
+    }
+    return sum;
+  });
+  std::remove(text_path);
+  std::remove(binary_path);
+}
+
+// Shifts and masks next to the multiplications and divisions by powers of two that emulated them.
+void BitOperations(std::mt19937& rng) {
+  BigInteger::SetMaxDigits(std::numeric_limits<size_t>::max());
+  const size_t shift = 1000;
+  const BigInteger power = BigInteger(1) << shift;
+  const BigInteger mask = power - 1;
+  std::printf("\nns per operation, shift by %zu bits\n%-9s %14s %14s %14s %14s %14s %14s\n", shift, "digits",
+              "x * 2^k", "x << k", "x / 2^k", "x >> k", "x % 2^k", "x & (2^k-1)");
+  for (size_t digits : {1'000, 10'000, 100'000}) {
+    const BigInteger x(RandomDigits(digits, rng));
+    const size_t runs = std::max<size_t>(1, 100'000'000 / digits);
+    double multiply_ns = NanosecondsPerRun(runs, [&] { sink = static_cast<bool>(x * power); });
+    double left_ns = NanosecondsPerRun(runs, [&] { sink = static_cast<bool>(x << shift); });
+    double divide_ns = NanosecondsPerRun(runs, [&] { sink = static_cast<bool>(x / power); });
+    double right_ns = NanosecondsPerRun(runs, [&] { sink = static_cast<bool>(x >> shift); });
+    double remainder_ns = NanosecondsPerRun(runs, [&] { sink = static_cast<bool>(x % power); });
+    double and_ns = NanosecondsPerRun(runs, [&] { sink = static_cast<bool>(x & mask); });
+    std::printf("%-9zu %14.0f %14.0f %14.0f %14.0f %14.0f %14.0f\n", digits, multiply_ns, left_ns, divide_ns, right_ns,
+                remainder_ns, and_ns);
+  }
+  BigInteger::SetMaxDigits(BigInteger::kDefaultMaxDigits);
+}
+
+// Gcd against Euclid's algorithm by remainders, ISqrt of a 2n-digit value against an n x n multiplication, and Pow
+// against repeated multiplication.
+void NumberTheory(std::mt19937& rng) {
+  BigInteger::SetMaxDigits(std::numeric_limits<size_t>::max());
+  std::printf("\nms per operation\n%-9s %14s %14s %9s %14s %14s %14s %14s\n", "digits", "euclid", "Gcd", "speedup",
+              "ISqrt 2n", "mul n x n", "x^100 by *", "Pow(x, 100)");
+  for (size_t digits : {1'000, 10'000, 30'000}) {
+    const BigInteger a(RandomDigits(digits, rng));
+    const BigInteger b(RandomDigits(digits, rng));
+    const size_t runs = std::max<size_t>(1, 10'000 / digits);
+    BigInteger euclid;
+    BigInteger gcd;
+    double euclid_ms = NanosecondsPerRun(runs, [&] {
+      BigInteger x = a;
+      BigInteger y = b;
+      while (y) {
+        x %= y;
+        std::swap(x, y);
+      }
+      euclid = x;
+    }) / 1e6;
+    double gcd_ms = NanosecondsPerRun(runs, [&] { gcd = Gcd(a, b); }) / 1e6;
+    sink = static_cast<size_t>(euclid == gcd);
+
+    const BigInteger square = a * b;
+    double sqrt_ms = NanosecondsPerRun(runs, [&] { sink = static_cast<bool>(ISqrt(square)); }) / 1e6;
+    double mul_ms = NanosecondsPerRun(runs, [&] { sink = static_cast<bool>(a * b); }) / 1e6;
+
+    const BigInteger base(RandomDigits(digits / 100, rng));
+    double repeated_ms = NanosecondsPerRun(runs, [&] {
+      BigInteger power(1);
+      for (int i = 0; i < 100; ++i) {
+        power *= base;
+      }
+      sink = static_cast<bool>(power);
+    }) / 1e6;
+    double pow_ms = NanosecondsPerRun(runs, [&] { sink = static_cast<bool>(Pow(base, 100)); }) / 1e6;
+    std::printf("%-9zu %14.2f %14.2f %8.2fx %14.2f %14.2f %14.2f %14.2f\n", digits, euclid_ms, gcd_ms,
+                euclid_ms / gcd_ms, sqrt_ms, mul_ms, repeated_ms, pow_ms);
+  }
+  BigInteger::SetMaxDigits(BigInteger::kDefaultMaxDigits);
+}
+
+// Multiplications and a factorial by Product on 1, 2, 4 and 8 threads, with the speedup over one thread. The threads
+// can only help as far as the host has cores.
+void ParallelScaling(std::mt19937& rng) {
+  BigInteger::SetMaxDigits(std::numeric_limits<size_t>::max());
+  const size_t thread_counts[] = {1, 2, 4, 8};
+  std::printf("\nms per operation on %u hardware threads; speedup over 1 thread in parentheses\n%-20s",
+              std::thread::hardware_concurrency(), "operation");
+  for (size_t threads : thread_counts) {
+    std::printf(" %12zu thr.", threads);
+  }
+  std::printf("\n");
+  auto row = [&thread_counts](const std::string& name, size_t runs, auto f) {
+    std::printf("%-20s", name.c_str());
+    double single_ms = 0;
+    for (size_t threads : thread_counts) {
+      BigInteger::SetMultiplicationThreads(threads);
+      double ms = NanosecondsPerRun(runs, f) / 1e6;
+      single_ms = threads == 1 ? ms : single_ms;
+      std::printf(" %9.1f (%4.2f)", ms, single_ms / ms);
+    }
+    std::printf("\n");
+  };
+  for (size_t digits : {30'000, 300'000, 3'000'000}) {
+    const BigInteger a(RandomDigits(digits, rng));
+    const BigInteger b(RandomDigits(digits, rng));
+    row("mul " + std::to_string(digits), std::max<size_t>(1, 3'000'000 / digits),
+        [&] { sink = static_cast<bool>(a * b); });
+  }
+  for (int n : {20'000, 200'000}) {
+    std::vector<BigInteger> factors;
+    for (int i = 1; i <= n; ++i) {
+      factors.emplace_back(i);
+    }
+    row(std::to_string(n) + "!", 1, [&] { sink = static_cast<bool>(Product(factors)); });
+  }
+  BigInteger::SetMultiplicationThreads(1);
+  BigInteger::SetMaxDigits(BigInteger::kDefaultMaxDigits);
+}
+
+// Odd number of exactly bits bits, built 32 random bits at a time.
+BigInteger RandomOddBits(size_t bits, std::mt19937& rng) {
+  BigInteger value(1);
+  for (size_t i = 1; i < bits; i += 32) {
+    const size_t step = std::min<size_t>(32, bits - i);
+    value *= int64_t{1} << step;
+    value += static_cast<int64_t>(rng() >> (32 - step));
+  }
+  return value % BigInteger(2) == BigInteger(0) ? value + 1 : value;
+}
+
+// Binary left-to-right powering with a long division after every product, which PowMod replaces.
+BigInteger NaivePowMod(const BigInteger& base, const std::vector<bool>& exponent_bits, const BigInteger& modulus) {
+  BigInteger result(1);
+  for (size_t i = exponent_bits.size(); i-- > 0;) {
+    result = result * result % modulus;
+    if (exponent_bits[i]) {
+      result = result * base % modulus;
+    }
+  }
+  return result;
+}
+
+// Full-length exponents modulo odd moduli of RSA sizes, plus the squaring kernels against general multiplication of
+// the same operand length.
+void ModularExponentiation(std::mt19937& rng) {
+  std::printf("\nus per operation\n%-6s %14s %14s %9s %14s %14s %9s\n", "bits", "naive powmod", "PowMod", "speedup",
+              "x * y", "x * x", "speedup");
+  for (size_t bits : {256, 1024, 2048, 4096}) {
+    const BigInteger modulus = RandomOddBits(bits, rng);
+    const BigInteger base = RandomOddBits(bits - 1, rng);
+    const BigInteger exponent = RandomOddBits(bits, rng);
+    std::vector<bool> exponent_bits;
+    for (BigInteger rest = exponent; rest; rest /= BigInteger(2)) {
+      exponent_bits.push_back(rest % BigInteger(2) == BigInteger(1));
+    }
+    const size_t runs = std::max<size_t>(1, 2'000'000'000 / (bits * bits * bits / 64));
+    BigInteger naive;
+    BigInteger fast;
+    double naive_us = NanosecondsPerRun(runs, [&] { naive = NaivePowMod(base, exponent_bits, modulus); }) / 1e3;
+    double fast_us = NanosecondsPerRun(runs, [&] { fast = PowMod(base, exponent, modulus); }) / 1e3;
+    sink = static_cast<size_t>(naive == fast);
+
+    const BigInteger copy = base;
+    const size_t products = 1'000'000'000 / (bits * bits / 32);
+    double multiply_us = NanosecondsPerRun(products, [&] { sink = static_cast<bool>(base * copy); }) / 1e3;
+    double square_us = NanosecondsPerRun(products, [&] {
+      BigInteger square = base;
+      square *= square;
+      sink = static_cast<bool>(square);
+    }) / 1e3;
+    std::printf("%-6zu %14.1f %14.1f %8.2fx %14.3f %14.3f %8.2fx\n", bits, naive_us, fast_us, naive_us / fast_us,
+                multiply_us, square_us, multiply_us / square_us);
+  }
+}
+
+// Division of a 2n-digit number by an n-digit one next to an n x n multiplication. Knuth's algorithm D alone would
+// make the ratio grow linearly with n; with the recursive division it grows only by a logarithmic factor.
+void DivisionCost(std::mt19937& rng) {
+  BigInteger::SetMaxDigits(std::numeric_limits<size_t>::max());
+  std::printf("\nns per operation\n%-9s %14s %14s %9s\n", "digits", "div 2n / n", "mul n x n", "ratio");
+  for (size_t digits : {1'000, 10'000, 100'000, 300'000}) {
+    const BigInteger a(RandomDigits(2 * digits, rng));
+    const BigInteger b(RandomDigits(digits, rng));
+    const size_t runs = std::max<size_t>(1, 10'000'000'000 / (digits * digits));
+    double div_ns = NanosecondsPerRun(runs, [&] { sink = static_cast<bool>(a / b); });
+    double mul_ns = NanosecondsPerRun(runs, [&] { sink = static_cast<bool>(b * b); });
+    std::printf("%-9zu %14.0f %14.0f %8.2fx\n", digits, div_ns, mul_ns, div_ns / mul_ns);
+  }
+  BigInteger::SetMaxDigits(BigInteger::kDefaultMaxDigits);
+}
+
+// Times multiplication of two random numbers with the given number of decimal digits for each candidate and returns
+// the fastest.
+template <typename F>
+size_t FastestThreshold(const std::vector<size_t>& candidates, F make, const char* name, size_t digits, size_t runs,
+                        std::mt19937& rng) {
+  const BigInteger a(RandomDigits(digits, rng));
+  const BigInteger b(RandomDigits(digits, rng));
+  size_t best = candidates.front();
+  double best_ns = std::numeric_limits<double>::infinity();
+  for (size_t candidate : candidates) {
+    BigInteger::SetMultiplicationThresholds(make(candidate));
+    double ns = NanosecondsPerRun(runs, [&] { sink = static_cast<bool>(a * b); });
+    std::printf("%-9s %7zu %7zu %14.0f\n", name, digits, candidate, ns);
+    if (ns < best_ns) {
+      best = candidate;
+      best_ns = ns;
+    }
+  }
+  return best;
+}
+
+// Picks the Karatsuba cutoff with Toom-3 and the NTT disabled, then the Toom-3 cutoff on top of it, then the NTT
+// cutoff. The NTT pays off only well past the default digit cap, so the cap is lifted.
+void TuneMultiplicationThresholds(std::mt19937& rng) {
+  const size_t never = std::numeric_limits<size_t>::max();
+  BigInteger::SetMaxDigits(never);
+  std::printf("\nns per multiplication by threshold\n%-9s %7s %7s %14s\n", "cutoff", "digits", "limbs", "ns");
+  size_t karatsuba = FastestThreshold(
+      {8, 12, 16, 24, 32, 48, 64, 96, 128},
+      [never](size_t candidate) { return BigInteger::MultiplicationThresholds{candidate, never, never}; },
+      "karatsuba", 14'000, 50, rng);
+  size_t toom3 = FastestThreshold(
+      {64, 96, 128, 160, 192, 256, 384, 512, 768, 1024},
+      [=](size_t candidate) { return BigInteger::MultiplicationThresholds{karatsuba, candidate, never}; }, "toom3",
+      14'000, 50, rng);
+  size_t ntt = FastestThreshold(
+      {1024, 2048, 3072, 4096, 6144, 8192, 12288, 16384},
+      [=](size_t candidate) { return BigInteger::MultiplicationThresholds{karatsuba, toom3, candidate}; }, "ntt",
+      100'000, 10, rng);
+  std::printf("recommended: BigInteger::SetMultiplicationThresholds({%zu, %zu, %zu})\n", karatsuba, toom3, ntt);
+}
+
+// Multiplication of numbers far beyond the default digit cap, with and without the NTT.
+void HugeMultiplication(std::mt19937& rng) {
+  const size_t never = std::numeric_limits<size_t>::max();
+  const auto thresholds = BigInteger::GetMultiplicationThresholds();
+  BigInteger::SetMaxDigits(never);
+  std::printf("\nms per multiplication\n%-9s %14s %14s\n", "digits", "toom-3", "ntt");
+  for (size_t digits : {100'000, 300'000, 1'000'000}) {
+    const BigInteger a(RandomDigits(digits, rng));
+    const BigInteger b(RandomDigits(digits, rng));
+    BigInteger::SetMultiplicationThresholds({thresholds.karatsuba, thresholds.toom3, never});
+    double toom3_ns = NanosecondsPerRun(1, [&] { sink = static_cast<bool>(a * b); });
+    BigInteger::SetMultiplicationThresholds(thresholds);
+    double ntt_ns = NanosecondsPerRun(1, [&] { sink = static_cast<bool>(a * b); });
+    std::printf("%-9zu %14.1f %14.1f\n", digits, toom3_ns / 1e6, ntt_ns / 1e6);
+  }
+  BigInteger::SetMaxDigits(BigInteger::kDefaultMaxDigits);
+}
+
+int main() {
+  std::mt19937 rng(42);
+  std::printf("ns per operation on random operands of the given decimal length\n");
+  std::printf("%-4s %9s %14s %14s %9s\n", "op", "digits", "base 10^4", "base 2^32", "speedup");
+  for (size_t digits : {100, 10'000, 1'000'000}) {
+    Compare(digits, rng);
+  }
+  MixedSmallWorkload(rng);
+  SmallOperandLoops(rng);
+  HugeMultiplication(rng);
+  DivisionCost(rng);
+  DecimalConversion(rng);
+  LoadFromDisk(rng);
+  BitOperations(rng);
+  ModularExponentiation(rng);
+  NumberTheory(rng);
+  ParallelScaling(rng);
+  TuneMultiplicationThresholds(rng);
+  return 0;
+}
@@ -1,7 +1,15 @@
 #define CATCH_CONFIG_MAIN
 #include "catch.hpp"
 
+#include <cstddef>
+#include <cstring>
 #include <iostream>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
 
 #include "big_integer.h"
 #include "big_integer.h"  // check include guards
@@ -118,6 +126,323 @@ TEST_CASE("Multiplication") {
                     BigIntegerOverflow);  // NOLINT
 }
 
+TEST_CASE("LimbBoundaries") {
+  const BigInteger two_32("4294967296");
+  const BigInteger two_64("18446744073709551616");
+  REQUIRE(BigInteger(int64_t{4294967295}) + BigInteger(1) == two_32);
+  REQUIRE(two_32 * two_32 == two_64);
+  REQUIRE(two_64 - BigInteger(1) == BigInteger("18446744073709551615"));
+  REQUIRE(BigInteger(1) - two_64 == BigInteger("-18446744073709551615"));
+  REQUIRE(BigInteger(std::numeric_limits<int64_t>::min()) == BigInteger("-9223372036854775808"));
+
+  std::ostringstream oss;
+  oss << two_64 * two_64 << ' ' << BigInteger("1000000000") << ' ' << BigInteger("-1000000000000000000");
+  REQUIRE(oss.str() == "340282366920938463463374607431768211456 1000000000 -1000000000000000000");
+}
+
+TEST_CASE("DecimalConversion") {
+  REQUIRE(BigInteger(0).ToString() == "0");
+  REQUIRE(BigInteger("-0").ToString() == "0");
+  REQUIRE(BigInteger("+000123").ToString() == "123");
+  REQUIRE(BigInteger(-1000000000).ToString() == "-1000000000");
+
+  char buffer[32];
+  const BigInteger negative("-18446744073709551616");
+  REQUIRE(negative.MaxCharsLength() <= sizeof(buffer));
+  REQUIRE(std::string(buffer, negative.ToChars(buffer)) == "-18446744073709551616");
+
+  // Lengths around the nine-digit chunks and the power-of-ten splits, with long runs of zeros and nines.
+  for (size_t digits : {8, 9, 10, 288, 289, 576, 577, 1152, 1153, 4608, 4609, 25000}) {
+    const std::string ones(digits, '1');
+    const std::string power = "1" + std::string(digits, '0');
+    const std::string nines(digits, '9');
+    const std::string sparse = "5" + std::string(digits / 2, '0') + "7" + std::string(digits / 2, '0') + "3";
+    for (const std::string& text : {ones, power, nines, sparse}) {
+      const BigInteger value(text);
+      REQUIRE(value.ToString() == text);
+      REQUIRE((-value).ToString() == "-" + text);
+      std::string chars(value.MaxCharsLength(), '\0');
+      chars.resize(value.ToChars(chars.data()) - chars.data());
+      REQUIRE(chars == text);
+    }
+    REQUIRE(BigInteger(power) - BigInteger(1) == BigInteger(nines));
+  }
+
+  std::mt19937 rng(99);
+  std::string random(20000, '0');
+  for (char& c : random) {
+    c = static_cast<char>('0' + rng() % 10);
+  }
+  random[0] = '4';
+  std::ostringstream oss;
+  oss << BigInteger(random);
+  REQUIRE(oss.str() == random);
+}
+
+TEST_CASE("Serialization") {
+  const BigInteger value("-18446744073709551617");
+  std::vector<std::byte> bytes(value.SerializedSize());
+  REQUIRE(value.Serialize(bytes.data()) == bytes.data() + bytes.size());
+  const unsigned char expected[] = {7, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0};
+  REQUIRE(bytes.size() == sizeof(expected));
+  REQUIRE(std::memcmp(bytes.data(), expected, sizeof(expected)) == 0);
+  REQUIRE(BigInteger(0).SerializedSize() == 4);
+
+  // Records follow each other without padding.
+  std::vector<BigInteger> values = {0, 1, -1, BigInteger("4294967296"), BigInteger("-" + std::string(3000, '7'))};
+  size_t total = 0;
+  for (const BigInteger& x : values) {
+    total += x.SerializedSize();
+  }
+  bytes.assign(total, std::byte{0});
+  std::byte* out = bytes.data();
+  for (const BigInteger& x : values) {
+    out = x.Serialize(out);
+  }
+  REQUIRE(out == bytes.data() + total);
+  const std::byte* in = bytes.data();
+  for (const BigInteger& x : values) {
+    BigInteger read(12345);
+    in = BigInteger::Deserialize(in, bytes.data() + total, read);
+    REQUIRE(read == x);
+  }
+  REQUIRE(in == bytes.data() + total);
+
+  BigInteger read;
+  REQUIRE_THROWS_AS(BigInteger::Deserialize(bytes.data(), bytes.data() + 3, read), BigIntegerFormatError);
+  const std::byte* long_record = bytes.data() + 16;
+  REQUIRE_THROWS_AS(BigInteger::Deserialize(long_record, long_record + 11, read), BigIntegerFormatError);
+  const std::byte negative_zero[] = {std::byte{1}, std::byte{0}, std::byte{0}, std::byte{0}};
+  REQUIRE_THROWS_AS(BigInteger::Deserialize(negative_zero, negative_zero + 4, read), BigIntegerFormatError);
+  const std::byte leading_zero[] = {std::byte{2}, std::byte{0}, std::byte{0}, std::byte{0},
+                                    std::byte{0}, std::byte{0}, std::byte{0}, std::byte{0}};
+  REQUIRE_THROWS_AS(BigInteger::Deserialize(leading_zero, leading_zero + 8, read), BigIntegerFormatError);
+}
+
+TEST_CASE("BigIntegerView") {
+  const std::vector<BigInteger> values = {BigInteger("-18446744073709551616"), -5, 0, 7, BigInteger("4294967296"),
+                                          BigInteger(std::string(500, '3'))};
+  std::vector<uint32_t> storage(1000);
+  std::byte* out = reinterpret_cast<std::byte*>(storage.data());
+  for (const BigInteger& x : values) {
+    out = x.Serialize(out);
+  }
+  const std::byte* in = reinterpret_cast<const std::byte*>(storage.data());
+  std::vector<BigIntegerView> views(values.size());
+  for (BigIntegerView& view : views) {
+    in = BigIntegerView::Deserialize(in, out, view);
+  }
+  REQUIRE(in == out);
+
+  for (size_t i = 0; i < values.size(); ++i) {
+    REQUIRE(BigInteger(views[i]) == values[i]);
+    REQUIRE(views[i].IsNegative() == values[i].IsNegative());
+    REQUIRE(static_cast<bool>(views[i]) == static_cast<bool>(values[i]));
+    for (size_t j = 0; j < values.size(); ++j) {
+      REQUIRE((views[i] < views[j]) == (values[i] < values[j]));
+      REQUIRE((views[i] == values[j]) == (i == j));
+      REQUIRE((values[i] >= views[j]) == (i >= j));
+      REQUIRE(views[i] + views[j] == values[i] + values[j]);
+      REQUIRE(views[i] - values[j] == values[i] - values[j]);
+      BigInteger sum = values[i];
+      sum += views[j];
+      REQUIRE(sum == values[i] + values[j]);
+      sum -= views[i];
+      REQUIRE(sum == values[j]);
+    }
+  }
+
+  BigInteger x(123);
+  x += BigIntegerView(x);
+  REQUIRE(x == 246);
+  REQUIRE(BigIntegerView() == BigInteger(0));
+
+  const std::byte* misaligned = reinterpret_cast<const std::byte*>(storage.data()) + 1;
+  BigIntegerView view;
+  REQUIRE_THROWS_AS(BigIntegerView::Deserialize(misaligned, misaligned + 8, view), BigIntegerFormatError);
+}
+
+TEST_CASE("MultiplicationDigitLimit") {
+  const BigInteger nines_15005(std::string(15005, '9'));
+  const BigInteger nines_15004(std::string(15004, '9'));
+  REQUIRE_NOTHROW(nines_15005 * nines_15004);  // 30009 digits
+  REQUIRE_THROWS_AS((void)(BigInteger("1" + std::string(15005, '0')) * BigInteger("1" + std::string(15004, '0'))),
+                    BigIntegerOverflow);  // NOLINT
+}
+
+// Karatsuba, Toom-3 and the NTT must agree with the schoolbook kernel, including on unbalanced operands that go
+// through the chunked path and on operand lengths just around the split points.
+TEST_CASE("MultiplicationAlgorithms") {
+  const auto thresholds = BigInteger::GetMultiplicationThresholds();
+  const size_t never = std::numeric_limits<size_t>::max();
+  std::mt19937 rng(12345);
+  std::uniform_int_distribution<int> digit(0, 9);
+  auto random_number = [&](size_t digits) {
+    std::string s(digits, '0');
+    for (char& c : s) {
+      c = static_cast<char>('0' + digit(rng));
+    }
+    s[0] = '1' + digit(rng) % 9;
+    return BigInteger((digit(rng) % 2 ? "-" : "") + s);
+  };
+
+  const size_t sizes[][2] = {{90, 90}, {95, 87}, {300, 290}, {400, 120}, {1000, 999}, {2000, 1500}, {3000, 700},
+                             {5000, 5000}, {9000, 4000}, {12000, 300}, {15000, 14999}};
+  for (const auto& size : sizes) {
+    const BigInteger x = random_number(size[0]);
+    const BigInteger y = random_number(size[1]);
+    BigInteger::SetMultiplicationThresholds({never, never, never});
+    const BigInteger expected = x * y;
+    BigInteger::SetMultiplicationThresholds({4, never, never});
+    REQUIRE(x * y == expected);
+    BigInteger::SetMultiplicationThresholds({4, 9, never});
+    REQUIRE(x * y == expected);
+    REQUIRE(y * x == expected);
+    BigInteger::SetMultiplicationThresholds({4, 9, 1});
+    REQUIRE(x * y == expected);
+  }
+
+  // Every limb 0xFFFFFFFF maximises the carries between the interpolated coefficients.
+  BigInteger all_ones(1);
+  for (int i = 0; i < 700; ++i) {
+    all_ones *= BigInteger(int64_t{4294967296});
+  }
+  --all_ones;
+  BigInteger::SetMultiplicationThresholds({never, never, never});
+  const BigInteger square = all_ones * all_ones;
+  BigInteger::SetMultiplicationThresholds({4, 9, never});
+  REQUIRE(all_ones * all_ones == square);
+  REQUIRE(all_ones * (all_ones - BigInteger(1)) == square - all_ones);
+  BigInteger::SetMultiplicationThresholds({4, 9, 1});
+  REQUIRE(all_ones * all_ones == square);
+  REQUIRE(all_ones * (all_ones - BigInteger(1)) == square - all_ones);
+  BigInteger::SetMultiplicationThresholds(thresholds);
+}
+
+TEST_CASE("Squaring") {
+  const auto thresholds = BigInteger::GetMultiplicationThresholds();
+  const size_t never = std::numeric_limits<size_t>::max();
+  std::mt19937 rng(777);
+  BigInteger all_ones(1);
+  for (int i = 0; i < 600; ++i) {
+    all_ones *= BigInteger(int64_t{4294967296});
+  }
+  --all_ones;
+
+  // x *= x squares; x * copy multiplies. Both must agree for every algorithm, on random and all-ones limbs.
+  for (size_t digits : {1, 9, 10, 19, 20, 150, 700, 2000, 5780}) {
+    std::string s(digits, '0');
+    for (char& c : s) {
+      c = static_cast<char>('0' + rng() % 10);
+    }
+    s[0] = static_cast<char>('1' + rng() % 9);
+    for (const BigInteger& x : {BigInteger("-" + s), all_ones}) {
+      BigInteger::SetMultiplicationThresholds({never, never, never});
+      const BigInteger copy = x;
+      const BigInteger expected = x * copy;
+      for (BigInteger::MultiplicationThresholds setting :
+           {BigInteger::MultiplicationThresholds{never, never, never}, {4, never, never}, {4, 9, never}, {4, 9, 1}}) {
+        BigInteger::SetMultiplicationThresholds(setting);
+        BigInteger square = x;
+        square *= square;
+        REQUIRE(square == expected);
+      }
+    }
+  }
+  BigInteger::SetMultiplicationThresholds(thresholds);
+}
+
+TEST_CASE("ParallelMultiplication") {
+  BigInteger::SetMaxDigits(std::numeric_limits<size_t>::max());
+  std::mt19937 rng(31);
+  auto random_number = [&rng](size_t digits) {
+    std::string s(digits, '0');
+    for (char& c : s) {
+      c = static_cast<char>('0' + rng() % 10);
+    }
+    s[0] = static_cast<char>('1' + rng() % 9);
+    return BigInteger(s);
+  };
+  const size_t sizes[][2] = {{12000, 11000}, {40000, 10000}, {100000, 100000}};
+  std::vector<BigInteger> expected;
+  std::vector<std::pair<BigInteger, BigInteger>> operands;
+  for (const auto& size : sizes) {
+    operands.emplace_back(random_number(size[0]), -random_number(size[1]));
+    expected.push_back(operands.back().first * operands.back().second);
+  }
+  std::vector<BigInteger> factors;
+  BigInteger sequential(1);
+  for (int i = 1; i <= 3000; ++i) {
+    factors.push_back(i % 7 == 0 ? -random_number(i % 50 + 1) : BigInteger(i));
+    sequential *= factors.back();
+  }
+  REQUIRE(Product(factors) == sequential);
+
+  for (size_t threads : {2, 3, 4, 8}) {
+    BigInteger::SetMultiplicationThreads(threads);
+    REQUIRE(BigInteger::GetMultiplicationThreads() == threads);
+    for (size_t i = 0; i < operands.size(); ++i) {
+      REQUIRE(operands[i].first * operands[i].second == expected[i]);
+    }
+    REQUIRE(Product(factors) == sequential);
+  }
+  REQUIRE(Product({}) == BigInteger(1));
+  REQUIRE(Product({BigInteger(5), BigInteger(0), BigInteger(-3)}) == BigInteger(0));
+  REQUIRE(Product({BigInteger(-5)}) == BigInteger(-5));
+  BigInteger::SetMultiplicationThreads(1);
+  REQUIRE(BigInteger::GetMultiplicationThreads() == 1);
+  BigInteger::SetMaxDigits(BigInteger::kDefaultMaxDigits);
+}
+
+TEST_CASE("ConfigurableDigitLimit") {
+  REQUIRE(BigInteger::GetMaxDigits() == 30009);
+  const BigInteger ten_5("100000");
+  const BigInteger ten_4("10000");
+
+  BigInteger::SetMaxDigits(10);
+  REQUIRE(ten_5 * ten_4 == BigInteger(1000000000));
+  REQUIRE(BigInteger(99999) * BigInteger(99999) == BigInteger(int64_t{9999800001}));
+  REQUIRE_THROWS_AS((void)(ten_5 * ten_5), BigIntegerOverflow);  // NOLINT
+
+  // Far above the default limit, where the products go through the NTT.
+  BigInteger::SetMaxDigits(200'000);
+  const BigInteger ten_100k = BigInteger("1" + std::string(50'000, '0')) * BigInteger("1" + std::string(50'000, '0'));
+  std::ostringstream oss;
+  oss << ten_100k * BigInteger("1" + std::string(99'999, '0')) - BigInteger(1);
+  REQUIRE(oss.str() == std::string(199'999, '9'));
+  REQUIRE_THROWS_AS((void)(ten_100k * ten_100k), BigIntegerOverflow);  // NOLINT
+
+  BigInteger::SetMaxDigits(std::numeric_limits<size_t>::max());
+  REQUIRE_NOTHROW(ten_100k * ten_100k);
+
+  BigInteger::SetMaxDigits(30009);
+}
+
+// Products at the default limit compare against the cached power of ten, which the threads share.
+TEST_CASE("DigitLimitFromSeveralThreads") {
+  const BigInteger largest(std::string(30009, '9'));
+  std::vector<std::thread> threads;
+  std::vector<int> passed(4);
+  for (size_t t = 0; t < passed.size(); ++t) {
+    threads.emplace_back([&largest, &passed, t] {
+      for (int i = 0; i < 50; ++i) {
+        const BigInteger value = largest - BigInteger(i);
+        bool overflowed = false;
+        try {
+          (void)((value + BigInteger(i + 1)) * BigInteger(1));
+        } catch (const BigIntegerOverflow&) {
+          overflowed = true;
+        }
+        passed[t] += value * BigInteger(1) == value && overflowed;
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  REQUIRE(passed == std::vector<int>(4, 50));
+}
+
 TEST_CASE("Increment") {
   BigInteger x = 0;
   REQUIRE(++x == BigInteger(1));
@@ -172,6 +497,160 @@ void CheckComparisonGreater(const T& lhs, const T& rhs) {
   REQUIRE(lhs > rhs);
 }
 
+TEST_CASE("LimbVector") {
+  LimbVector limbs;
+  limbs.PushBack(1);
+  limbs.PushBack(2);
+  REQUIRE(limbs.IsInline());
+  limbs.PushBack(3);
+  REQUIRE_FALSE(limbs.IsInline());
+  REQUIRE(limbs == LimbVector({1, 2, 3}));
+
+  LimbVector copy = limbs;
+  REQUIRE(copy == limbs);
+  LimbVector moved = std::move(limbs);
+  REQUIRE(moved == copy);
+  REQUIRE(limbs.Empty());
+  REQUIRE(limbs.IsInline());
+
+  LimbVector small = {7, 8};
+  LimbVector moved_small = std::move(small);
+  REQUIRE(moved_small == LimbVector({7, 8}));
+  REQUIRE(moved_small.IsInline());
+  moved = moved_small;
+  REQUIRE(moved == LimbVector({7, 8}));
+  moved = moved;
+  REQUIRE(moved == LimbVector({7, 8}));
+
+  moved.Resize(5, 9);
+  REQUIRE(moved == LimbVector({7, 8, 9, 9, 9}));
+  moved.PopBack();
+  moved.Assign(1, 4);
+  REQUIRE(moved == LimbVector(1, 4));
+  moved_small = std::move(copy);
+  REQUIRE(moved_small == LimbVector({1, 2, 3}));
+}
+
+TEST_CASE("SmallOperands") {
+  BigInteger x(-1);
+  REQUIRE(++x == BigInteger(0));
+  REQUIRE(!(x++).IsNegative());
+  REQUIRE(--x == BigInteger(0));
+  REQUIRE(--x == BigInteger(-1));
+
+  BigInteger y("4294967295");
+  REQUIRE(++y == BigInteger("4294967296"));
+  REQUIRE(--y == BigInteger("4294967295"));
+  BigInteger z("-18446744073709551616");
+  REQUIRE(++z == BigInteger("-18446744073709551615"));
+  REQUIRE(--z == BigInteger("-18446744073709551616"));
+
+  const int64_t min = std::numeric_limits<int64_t>::min();
+  const int64_t max = std::numeric_limits<int64_t>::max();
+  const BigInteger values[] = {BigInteger(0), BigInteger(7), BigInteger(-7), BigInteger("4294967296"),
+                               BigInteger("-18446744073709551617"), BigInteger("123456789012345678901234567890")};
+  for (const BigInteger& value : values) {
+    for (int64_t small : {int64_t{0}, int64_t{1}, int64_t{-1}, int64_t{4294967295}, int64_t{-4294967296}, min, max}) {
+      REQUIRE(value + small == value + BigInteger(small));
+      REQUIRE(value - small == value - BigInteger(small));
+      REQUIRE(value * small == value * BigInteger(small));
+    }
+  }
+}
+
+TEST_CASE("AddMul") {
+  const BigInteger a("-98765432109876543210987654321");
+  const BigInteger b("12345678901234567890");
+  const BigInteger long_factor(std::string(700, '7'));
+  for (const BigInteger& start : {BigInteger(0), BigInteger(5), BigInteger(-5), a * a, -(a * a)}) {
+    for (const BigInteger& factor : {b, -b, long_factor, BigInteger(0)}) {
+      BigInteger sum = start;
+      REQUIRE(sum.AddMul(a, factor) == start + a * factor);
+      BigInteger difference = start;
+      REQUIRE(difference.SubMul(factor, a) == start - a * factor);
+    }
+  }
+
+  BigInteger accumulator = b;
+  accumulator.AddMul(accumulator, accumulator);
+  REQUIRE(accumulator == b + b * b);
+  accumulator.SubMul(a, accumulator);
+  REQUIRE(accumulator == (b + b * b) * (BigInteger(1) - a));
+}
+
+TEST_CASE("BitwiseOperators") {
+  // Two's complement semantics: every combination of signs agrees with int64_t.
+  const int64_t values[] = {0, 1, -1, 6, -6, 255, -256, 4294967295, -4294967296, 4294967297, -4294967297,
+                            1234567890123, -987654321098};
+  for (int64_t x : values) {
+    REQUIRE(~BigInteger(x) == BigInteger(~x));
+    for (int64_t y : values) {
+      REQUIRE((BigInteger(x) & BigInteger(y)) == BigInteger(x & y));
+      REQUIRE((BigInteger(x) | BigInteger(y)) == BigInteger(x | y));
+      REQUIRE((BigInteger(x) ^ BigInteger(y)) == BigInteger(x ^ y));
+    }
+  }
+
+  const BigInteger big("-340282366920938463463374607431768211456");  // -2^128
+  BigInteger x = big;
+  x &= x;
+  REQUIRE(x == big);
+  x ^= x;
+  REQUIRE(x == BigInteger(0));
+  REQUIRE((big & BigInteger(-1)) == big);
+  REQUIRE((big | BigInteger(1)) == big + BigInteger(1));
+  REQUIRE(((big - BigInteger(1)) & big) == big * BigInteger(2));
+  REQUIRE((BigInteger("18446744073709551615") ^ BigInteger(-1)) == BigInteger("-18446744073709551616"));
+}
+
+TEST_CASE("Shifts") {
+  for (int64_t x : {int64_t{0}, int64_t{1}, int64_t{-1}, int64_t{5}, int64_t{-5}, int64_t{-4294967296},
+                    int64_t{1234567890123}, int64_t{-1234567890123}}) {
+    for (size_t shift : {0, 1, 7, 31, 32, 33, 40}) {
+      REQUIRE((BigInteger(x) >> shift) == BigInteger(x >> shift));
+      if (x >= -(int64_t{1} << 22) && x < (int64_t{1} << 22)) {
+        REQUIRE((BigInteger(x) << shift) == BigInteger(x * (int64_t{1} << shift)));
+      }
+    }
+  }
+
+  BigInteger power(1);
+  for (int i = 0; i < 200; ++i) {
+    power *= BigInteger(2);
+  }
+  REQUIRE((BigInteger(1) << 200) == power);
+  REQUIRE((BigInteger(-3) << 200) == BigInteger(-3) * power);
+  REQUIRE((power >> 200) == BigInteger(1));
+  REQUIRE(((power + BigInteger(1)) >> 199) == BigInteger(2));
+  REQUIRE((-power >> 200) == BigInteger(-1));
+  REQUIRE(((-power - BigInteger(1)) >> 200) == BigInteger(-2));
+  REQUIRE((-power >> 5000) == BigInteger(-1));
+  REQUIRE((power >> 5000) == BigInteger(0));
+
+  BigInteger shifted(7);
+  shifted <<= 100;
+  shifted >>= 99;
+  REQUIRE(shifted == BigInteger(14));
+  REQUIRE_THROWS_AS(BigInteger(1) << 1'000'000'000'000, BigIntegerOverflow);  // NOLINT
+  REQUIRE_THROWS_AS(BigInteger(1) << 100'000, BigIntegerOverflow);            // NOLINT
+}
+
+TEST_CASE("BitQueries") {
+  REQUIRE(BigInteger(0).BitLength() == 0);
+  REQUIRE(BigInteger(0).PopCount() == 0);
+  REQUIRE(BigInteger(1).BitLength() == 1);
+  REQUIRE(BigInteger(-255).BitLength() == 8);
+  REQUIRE(BigInteger(-255).PopCount() == 8);
+  REQUIRE(BigInteger(int64_t{4294967296}).BitLength() == 33);
+  REQUIRE(BigInteger("340282366920938463463374607431768211455").PopCount() == 128);  // 2^128 - 1
+
+  for (int64_t x : {int64_t{0}, int64_t{6}, int64_t{-6}, int64_t{-4294967296}, int64_t{-12884901889}}) {
+    for (size_t index : {0, 1, 2, 31, 32, 33, 34, 63, 200}) {
+      REQUIRE(BigInteger(x).TestBit(index) == (((x >> std::min<size_t>(index, 63)) & 1) != 0));
+    }
+  }
+}
+
 TEST_CASE("RelationalOperators") {
   const BigInteger positive("1234567890123456789");
   const auto positive_copy = positive;
@@ -249,4 +728,176 @@ TEST_CASE("Residual") {
   REQUIRE(-y % -x == BigInteger(-90));
 }
 
+TEST_CASE("DivMod") {
+  const auto [quotient, remainder] = DivMod(BigInteger(-193), BigInteger(5));
+  REQUIRE(quotient == BigInteger(-38));
+  REQUIRE(remainder == BigInteger(-3));
+  REQUIRE_THROWS_AS(DivMod(BigInteger(1), BigInteger(0)), BigIntegerDivisionByZero);  // NOLINT
+
+  // The first quotient limb estimate is one too large and survives the two-limb check, so the add-back step runs.
+  const BigInteger u("170141183420855150474555134919112130560");
+  const BigInteger v("39614081257132168796771975169");
+  REQUIRE(u / v == BigInteger(int64_t{4294967294}));
+  REQUIRE(u % v == BigInteger("39614081257132168792477007874"));
+
+  // Sizes on both sides of the recursion threshold, with the identity lhs = q * rhs + r, |r| < |rhs|.
+  std::mt19937 rng(2024);
+  auto random_number = [&rng](size_t digits) {
+    std::string s(digits, '0');
+    for (char& c : s) {
+      c = static_cast<char>('0' + rng() % 10);
+    }
+    s[0] = static_cast<char>('1' + rng() % 9);
+    return BigInteger((rng() % 2 ? "-" : "") + s);
+  };
+  const size_t sizes[][2] = {{30, 12}, {200, 190}, {1000, 500}, {2000, 600}, {5000, 2500}, {12000, 5000},
+                             {20000, 9000}, {29000, 400}, {9000, 9000}};
+  for (const auto& size : sizes) {
+    const BigInteger lhs = random_number(size[0]);
+    const BigInteger rhs = random_number(size[1]);
+    const auto [q, r] = DivMod(lhs, rhs);
+    REQUIRE(q * rhs + r == lhs);
+    REQUIRE(r.Abs() < rhs.Abs());
+    REQUIRE((!r || r.IsNegative() == lhs.IsNegative()));
+    REQUIRE(lhs * rhs / rhs == lhs);
+  }
+}
+
+TEST_CASE("PowMod") {
+  REQUIRE(PowMod(BigInteger(4), BigInteger(13), BigInteger(497)) == BigInteger(445));
+  REQUIRE(PowMod(BigInteger(-4), BigInteger(13), BigInteger(497)) == BigInteger(52));
+  REQUIRE(PowMod(BigInteger(3), BigInteger(200), BigInteger(-1000)) == BigInteger(1));
+  REQUIRE(PowMod(BigInteger(7), BigInteger(0), BigInteger(10)) == BigInteger(1));
+  REQUIRE(PowMod(BigInteger(7), BigInteger(0), BigInteger(1)) == BigInteger(0));
+  REQUIRE(PowMod(BigInteger(0), BigInteger(5), BigInteger(11)) == BigInteger(0));
+  REQUIRE_THROWS_AS(PowMod(BigInteger(2), BigInteger(3), BigInteger(0)), BigIntegerDivisionByZero);  // NOLINT
+  REQUIRE_THROWS_AS(PowMod(BigInteger(2), BigInteger(-3), BigInteger(5)), BigIntegerDomainError);    // NOLINT
+
+  // Fermat: a^(p - 1) = 1 mod p for the primes 2^127 - 1 and 2^521 - 1; exponents of 127 and 521 bits take the
+  // 4- and 5-bit windows.
+  for (int exponent : {127, 521}) {
+    BigInteger prime(1);
+    for (int i = 0; i < exponent; ++i) {
+      prime *= BigInteger(2);
+    }
+    --prime;
+    REQUIRE(PowMod(BigInteger("123456789123456789"), prime - BigInteger(1), prime) == BigInteger(1));
+    REQUIRE(PowMod(BigInteger(3), prime, prime) == BigInteger(3));
+    // Even moduli take the long division path: 3^(2^k) = 1 mod 2^(k + 2).
+    REQUIRE(PowMod(BigInteger(3), prime + BigInteger(1), BigInteger(4) * (prime + BigInteger(1))) == BigInteger(1));
+  }
+}
+
+TEST_CASE("MontgomeryContext") {
+  REQUIRE_THROWS_AS(MontgomeryContext(BigInteger(10)), BigIntegerDomainError);   // NOLINT
+  REQUIRE_THROWS_AS(MontgomeryContext(BigInteger(-7)), BigIntegerDomainError);   // NOLINT
+
+  const BigInteger modulus("340282366920938463463374607431768211507");  // 2^128 + 51
+  const MontgomeryContext context(modulus);
+  REQUIRE(context.Modulus() == modulus);
+  const BigInteger x("98765432109876543210987654321");
+  const BigInteger y("-1234567890123456789012345678901234567");
+  const BigInteger x_form = context.ToMontgomery(x);
+  const BigInteger y_form = context.ToMontgomery(y);
+  REQUIRE(x_form < modulus);
+  REQUIRE(context.FromMontgomery(x_form) == x);
+  REQUIRE(context.FromMontgomery(context.Multiply(x_form, y_form)) == (x * y % modulus + modulus) % modulus);
+  REQUIRE(context.FromMontgomery(context.Square(y_form)) == y * y % modulus);
+  REQUIRE(context.PowMod(x, BigInteger(65537)) == PowMod(x, BigInteger(65537), modulus));
+
+  BigInteger naive(1);
+  for (int i = 0; i < 100; ++i) {
+    naive = naive * y % modulus;
+  }
+  REQUIRE(context.PowMod(y, BigInteger(100)) == (naive + modulus) % modulus);
+}
+
+TEST_CASE("Gcd") {
+  REQUIRE(Gcd(BigInteger(0), BigInteger(0)) == BigInteger(0));
+  REQUIRE(Gcd(BigInteger(0), BigInteger(-12)) == BigInteger(12));
+  REQUIRE(Gcd(BigInteger(-12), BigInteger(18)) == BigInteger(6));
+  REQUIRE(Gcd(BigInteger("18446744073709551615"), BigInteger("12297829382473034410")) ==
+          BigInteger("6148914691236517205"));
+  REQUIRE(Lcm(BigInteger(4), BigInteger(-6)) == BigInteger(12));
+  REQUIRE(Lcm(BigInteger(0), BigInteger(5)) == BigInteger(0));
+
+  // Against Euclid's algorithm on random multiples of a common factor, at lengths that take Lehmer steps, the
+  // half-GCD and a first division; consecutive Fibonacci numbers have the longest quotient sequences.
+  std::mt19937 rng(99);
+  auto random_number = [&rng](size_t digits) {
+    std::string s(digits, '0');
+    for (char& c : s) {
+      c = static_cast<char>('0' + rng() % 10);
+    }
+    s[0] = static_cast<char>('1' + rng() % 9);
+    return BigInteger(s);
+  };
+  const size_t sizes[][3] = {{30, 25, 5}, {300, 280, 40}, {2000, 2000, 10}, {6000, 5900, 800}, {9000, 1000, 300}};
+  for (const auto& size : sizes) {
+    const BigInteger factor = random_number(size[2]);
+    const BigInteger lhs = random_number(size[0]) * factor;
+    const BigInteger rhs = -random_number(size[1]) * factor;
+    BigInteger x = lhs;
+    BigInteger y = rhs.Abs();
+    while (y) {
+      x %= y;
+      std::swap(x, y);
+    }
+    const BigInteger gcd = Gcd(lhs, rhs);
+    REQUIRE(gcd == x);
+    REQUIRE(Gcd(rhs, lhs) == x);
+    REQUIRE(Lcm(lhs, rhs) * gcd == (lhs * rhs).Abs());
+  }
+  BigInteger fibonacci[2] = {1, 1};
+  for (int i = 0; i < 40000; ++i) {
+    fibonacci[i % 2] += fibonacci[(i + 1) % 2];
+  }
+  REQUIRE(Gcd(fibonacci[0], fibonacci[1]) == BigInteger(1));
+  REQUIRE(Gcd(fibonacci[0] * BigInteger(6), fibonacci[1] * BigInteger(10)) == BigInteger(2));
+}
+
+TEST_CASE("ISqrt") {
+  REQUIRE(ISqrt(BigInteger(0)) == BigInteger(0));
+  REQUIRE(ISqrt(BigInteger(15)) == BigInteger(3));
+  REQUIRE(ISqrt(BigInteger(16)) == BigInteger(4));
+  REQUIRE(ISqrt(BigInteger("18446744073709551615")) == BigInteger(int64_t{4294967295}));
+  REQUIRE(ISqrt(BigInteger("18446744073709551616")) == BigInteger(int64_t{4294967296}));
+  REQUIRE_THROWS_AS(ISqrt(BigInteger(-1)), BigIntegerDomainError);  // NOLINT
+
+  // r^2 <= n < (r + 1)^2 on random values and on squares and their neighbours.
+  std::mt19937 rng(5);
+  for (size_t digits : {19, 20, 21, 39, 40, 100, 1001, 5000, 20000}) {
+    std::string s(digits, '0');
+    for (char& c : s) {
+      c = static_cast<char>('0' + rng() % 10);
+    }
+    s[0] = static_cast<char>('1' + rng() % 9);
+    const BigInteger value(s);
+    const BigInteger root = ISqrt(value);
+    REQUIRE(root * root <= value);
+    REQUIRE((root + 1) * (root + 1) > value);
+    const BigInteger square = root * root;
+    REQUIRE(ISqrt(square) == root);
+    REQUIRE(ISqrt(square - 1) == root - 1);
+  }
+}
+
+TEST_CASE("Pow") {
+  REQUIRE(Pow(BigInteger(0), 0) == BigInteger(1));
+  REQUIRE(Pow(BigInteger(0), 5) == BigInteger(0));
+  REQUIRE(Pow(BigInteger(-1), 12345) == BigInteger(-1));
+  REQUIRE(Pow(BigInteger(-3), 4) == BigInteger(81));
+  REQUIRE(Pow(BigInteger(2), 64) == BigInteger("18446744073709551616"));
+  REQUIRE(Pow(BigInteger(10), 30008) == BigInteger("1" + std::string(30008, '0')));
+  REQUIRE_THROWS_AS(Pow(BigInteger(10), 30009), BigIntegerOverflow);  // NOLINT
+
+  // Against repeated multiplication for every exponent up to 70.
+  const BigInteger base("-98765432123456789");
+  BigInteger expected(1);
+  for (uint64_t exponent = 0; exponent <= 70; ++exponent) {
+    REQUIRE(Pow(base, exponent) == expected);
+    expected *= base;
+  }
+}
+
 #endif  // BIG_INTEGER_DIVISION_IMPLEMENTED
@@ -0,0 +1,204 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+
+// Vector of 32-bit limbs that keeps up to kInlineCapacity of them inside the object and uses the heap only past
+// that, so that values of up to 64 bits never allocate. The limbs are trivial: they are copied with memcpy on growth
+// and new ones get the value passed to Resize.
+class LimbVector {
+ public:
+  using ValueType = uint32_t;
+  using SizeType = size_t;
+  using Iterator = ValueType*;
+  using ConstIterator = const ValueType*;
+
+  static constexpr SizeType kInlineCapacity = 2;
+
+  LimbVector() : data_(inline_), size_(0) {
+  }
+
+  LimbVector(SizeType size, ValueType value) : LimbVector() {
+    Resize(size, value);
+  }
+
+  LimbVector(ConstIterator first, ConstIterator last) : LimbVector() {
+    Reserve(last - first);
+    std::copy(first, last, data_);
+    size_ = last - first;
+  }
+
+  LimbVector(std::initializer_list<ValueType> init) : LimbVector(init.begin(), init.end()) {
+  }
+
+  LimbVector(const LimbVector& other) : LimbVector(other.begin(), other.end()) {
+  }
+
+  LimbVector(LimbVector&& other) noexcept : LimbVector() {
+    StealFrom(other);
+  }
+
+  LimbVector& operator=(const LimbVector& other) {
+    if (this != &other) {
+      size_ = 0;
+      Reserve(other.size_);
+      std::copy(other.begin(), other.end(), data_);
+      size_ = other.size_;
+    }
+    return *this;
+  }
+
+  LimbVector& operator=(LimbVector&& other) noexcept {
+    if (this != &other) {
+      Release();
+      StealFrom(other);
+    }
+    return *this;
+  }
+
+  ~LimbVector() {
+    Release();
+  }
+
+  SizeType Size() const {
+    return size_;
+  }
+
+  SizeType Capacity() const {
+    return IsInline() ? kInlineCapacity : capacity_;
+  }
+
+  bool Empty() const {
+    return size_ == 0;
+  }
+
+  bool IsInline() const {
+    return data_ == inline_;
+  }
+
+  ValueType& operator[](SizeType index) {
+    return data_[index];
+  }
+
+  const ValueType& operator[](SizeType index) const {
+    return data_[index];
+  }
+
+  ValueType& Back() {
+    return data_[size_ - 1];
+  }
+
+  const ValueType& Back() const {
+    return data_[size_ - 1];
+  }
+
+  ValueType* Data() {
+    return data_;
+  }
+
+  const ValueType* Data() const {
+    return data_;
+  }
+
+  void Reserve(SizeType new_cap) {
+    if (new_cap > Capacity()) {
+      Reallocate(new_cap);
+    }
+  }
+
+  void Resize(SizeType new_size, ValueType value = 0) {
+    if (new_size > Capacity()) {
+      Reallocate(std::max(new_size, 2 * Capacity()));
+    }
+    if (new_size > size_) {
+      std::fill(data_ + size_, data_ + new_size, value);
+    }
+    size_ = new_size;
+  }
+
+  void Assign(SizeType size, ValueType value) {
+    size_ = 0;
+    Resize(size, value);
+  }
+
+  void Clear() {
+    size_ = 0;
+  }
+
+  void PushBack(ValueType value) {
+    if (size_ == Capacity()) {
+      Reallocate(2 * size_);
+    }
+    data_[size_++] = value;
+  }
+
+  void PopBack() {
+    --size_;
+  }
+
+  Iterator begin() {  // NOLINT
+    return data_;
+  }
+
+  ConstIterator begin() const {  // NOLINT
+    return data_;
+  }
+
+  Iterator end() {  // NOLINT
+    return data_ + size_;
+  }
+
+  ConstIterator end() const {  // NOLINT
+    return data_ + size_;
+  }
+
+  friend bool operator==(const LimbVector& l_value, const LimbVector& r_value) {
+    return l_value.size_ == r_value.size_ && std::equal(l_value.begin(), l_value.end(), r_value.begin());
+  }
+
+  friend bool operator!=(const LimbVector& l_value, const LimbVector& r_value) {
+    return !(l_value == r_value);
+  }
+
+ private:
+  ValueType* data_;
+  SizeType size_;
+  // The heap capacity shares the bytes of the inline limbs, which are unused once the data is on the heap.
+  union {
+    ValueType inline_[kInlineCapacity];
+    SizeType capacity_;
+  };
+
+  void Reallocate(SizeType new_capacity) {
+    auto new_data = new ValueType[new_capacity];
+    std::memcpy(new_data, data_, size_ * sizeof(ValueType));
+    if (!IsInline()) {
+      delete[] data_;
+    }
+    data_ = new_data;
+    capacity_ = new_capacity;
+  }
+
+  void Release() noexcept {
+    if (!IsInline()) {
+      delete[] data_;
+    }
+    data_ = inline_;
+    size_ = 0;
+  }
+
+  // Expects *this to be empty and inline.
+  void StealFrom(LimbVector& other) {
+    if (other.IsInline()) {
+      std::memcpy(inline_, other.inline_, other.size_ * sizeof(ValueType));
+    } else {
+      data_ = other.data_;
+      capacity_ = other.capacity_;
+      other.data_ = other.inline_;
+    }
+    size_ = other.size_;
+    other.size_ = 0;
+  }
+};
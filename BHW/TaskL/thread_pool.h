@@ -0,0 +1,98 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Fixed set of worker threads running submitted tasks in submission order. Tasks must not wait for other tasks of the
+// same pool, since they could occupy every worker; InWorker() lets code that may run either way choose not to.
+class ThreadPool {
+ public:
+  explicit ThreadPool(size_t threads) {
+    for (size_t i = 0; i < threads; ++i) {
+      workers_.emplace_back([this] { Run(); });
+    }
+  }
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  // Finishes the queued tasks, then joins the workers.
+  ~ThreadPool() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stopping_ = true;
+    }
+    ready_.notify_all();
+    for (auto& worker : workers_) {
+      worker.join();
+    }
+  }
+
+  size_t Size() const {
+    return workers_.size();
+  }
+
+  // The future holds the result of task or the exception it threw.
+  template <typename F>
+  std::future<std::invoke_result_t<F>> Submit(F task) {
+    auto packaged = std::make_shared<std::packaged_task<std::invoke_result_t<F>()>>(std::move(task));
+    auto result = packaged->get_future();
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      tasks_.emplace_back([packaged] { (*packaged)(); });
+    }
+    ready_.notify_one();
+    return result;
+  }
+
+  // Whether the calling thread is a worker of some pool.
+  static bool InWorker() {
+    return in_worker_;
+  }
+
+ private:
+  std::vector<std::thread> workers_;
+  std::deque<std::function<void()>> tasks_;
+  std::mutex mutex_;
+  std::condition_variable ready_;
+  bool stopping_ = false;
+
+  static inline thread_local bool in_worker_ = false;
+
+  void Run() {
+    in_worker_ = true;
+    while (true) {
+      std::function<void()> task;
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        ready_.wait(lock, [this] { return stopping_ || !tasks_.empty(); });
+        if (tasks_.empty()) {
+          return;
+        }
+        task = std::move(tasks_.front());
+        tasks_.pop_front();
+      }
+      task();
+    }
+  }
+};
+
+// Waits until every task behind futures has finished, without rethrowing what they threw. Callers whose tasks refer to
+// their locals call it before they return or rethrow, since the futures of Submit do not wait when destroyed.
+template <typename T>
+void WaitForAll(std::vector<std::future<T>>& futures) {
+  for (auto& future : futures) {
+    if (future.valid()) {
+      future.wait();
+    }
+  }
+}